@@ -0,0 +1,118 @@
+#include "BenchmarkReport.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace GameOfLife::SimulationBench {
+
+namespace {
+    const char* FORMAT_NAME = "gameoflife-simulation-bench";
+    const int FORMAT_VERSION = 1;
+}
+
+bool BenchmarkReport::write(const Measurements& measurements, const std::string& fileName) {
+    // property_tree would quote every number, so the output is written by hand and only parsed with it.
+    std::ofstream file(fileName);
+    if (!file) {
+        Log::Error(Print::composeMessage("Failed to open", fileName, "for writing"));
+        return false;
+    }
+
+    file << std::setprecision(6);
+    file << "{\n  \"format\": \"" << FORMAT_NAME << "\",\n  \"version\": " << FORMAT_VERSION << ",\n  \"results\": [";
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        const auto& measurement = measurements[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "    {\"name\": \"" << escape(measurement.name) << "\""
+             << ", \"operation\": \"" << escape(measurement.operation) << "\""
+             << ", \"width\": " << measurement.width
+             << ", \"height\": " << measurement.height
+             << ", \"fill_ratio\": " << measurement.fillRatio
+             << ", \"threads\": " << measurement.threadCount
+             << ", \"iterations\": " << measurement.iterations
+             << ", \"ns_per_cell\": " << measurement.nsPerCell
+             << ", \"cells_per_second\": " << measurement.cellsPerSecond << "}";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+std::optional<Measurements> BenchmarkReport::read(const std::string& fileName) {
+    namespace pt = boost::property_tree;
+    try {
+        pt::ptree tree;
+        pt::read_json(fileName, tree);
+        if (tree.get<std::string>("format", "") != FORMAT_NAME) {
+            Log::Error(Print::composeMessage(fileName, "is not a simulation benchmark report"));
+            return std::nullopt;
+        }
+
+        Measurements measurements;
+        for (const auto& [key, result] : tree.get_child("results")) {
+            Measurement measurement;
+            measurement.name = result.get<std::string>("name");
+            measurement.operation = result.get<std::string>("operation");
+            measurement.width = result.get<int>("width");
+            measurement.height = result.get<int>("height");
+            measurement.fillRatio = result.get<float>("fill_ratio");
+            measurement.threadCount = result.get<int>("threads");
+            measurement.iterations = result.get<uint64_t>("iterations");
+            measurement.nsPerCell = result.get<double>("ns_per_cell");
+            measurement.cellsPerSecond = result.get<double>("cells_per_second");
+            measurements.push_back(std::move(measurement));
+        }
+        return measurements;
+    }
+    catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Failed to read baseline", fileName, ":", e.what()));
+        return std::nullopt;
+    }
+}
+
+int BenchmarkReport::compare(const Measurements& measurements, const Measurements& baseline, double threshold) {
+    std::map<std::string, const Measurement*> baselineByName;
+    for (const auto& measurement : baseline) {
+        baselineByName[measurement.name] = &measurement;
+    }
+
+    Print::PrintLine("\nComparison against baseline:");
+    int regressions = 0;
+    for (const auto& measurement : measurements) {
+        auto it = baselineByName.find(measurement.name);
+        if (it == baselineByName.end()) {
+            continue;
+        }
+        const double change = measurement.nsPerCell / it->second->nsPerCell - 1.0;
+        const bool regressed = change > threshold;
+        regressions += regressed ? 1 : 0;
+
+        std::ostringstream line;
+        line << std::left << std::setw(44) << measurement.name << std::right << std::fixed << std::setprecision(3)
+             << std::setw(10) << it->second->nsPerCell << " ->" << std::setw(10) << measurement.nsPerCell << " ns/cell"
+             << std::showpos << std::setprecision(1) << std::setw(9) << change * 100 << '%' << std::noshowpos
+             << (regressed ? "  REGRESSION" : "");
+        Print::PrintLine(line.str());
+    }
+    Print::PrintLine(Print::composeMessage("Regressions beyond", threshold * 100, "%:", regressions));
+    return regressions;
+}
+
+std::string BenchmarkReport::escape(const std::string& value) {
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // namespace GameOfLife::SimulationBench
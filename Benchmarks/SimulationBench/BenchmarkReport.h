@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Measurement.h"
+
+#include <optional>
+#include <string>
+
+namespace GameOfLife::SimulationBench {
+
+// JSON persistence of a run and the regression check against an earlier one.
+class BenchmarkReport {
+public:
+    static bool write(const Measurements& measurements, const std::string& fileName);
+    static std::optional<Measurements> read(const std::string& fileName);
+    static int compare(const Measurements& measurements, const Measurements& baseline, double threshold);
+private:
+    static std::string escape(const std::string& value);
+};
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,164 @@
+#include "Config.h"
+#include "Print.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <optional>
+#include <sstream>
+
+namespace GameOfLife::SimulationBench {
+
+namespace {
+    template <typename T>
+    std::optional<std::vector<T>> parseList(const std::string& input, bool (*isValid)(T)) {
+        std::vector<T> values;
+        std::istringstream iss(input);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            std::istringstream itemStream(item);
+            T value;
+            itemStream >> value;
+            if (itemStream.fail() || !itemStream.eof() || !isValid(value)) {
+                return std::nullopt;
+            }
+            values.push_back(value);
+        }
+        if (values.empty()) {
+            return std::nullopt;
+        }
+        return values;
+    }
+
+    bool isValidGridSize(int size) {
+        return size >= 8 && size <= 16384;
+    }
+
+    bool isValidFillRatio(float ratio) {
+        return ratio >= 0.0f && ratio <= 1.0f;
+    }
+
+    bool isValidThreadCount(int count) {
+        return count >= 1 && count <= 64;
+    }
+}
+
+Config::Config()
+    : mDescription("Simulation Benchmark Options") {
+    namespace po = boost::program_options;
+    mDescription.add_options()
+        ("help,h", "produce help message")
+        ("grid-sizes,g", po::value<std::string>()->default_value("64,256,1024,4096,16384")->notifier(Config::validateGridSizes), "comma separated square grid sizes (8-16384)")
+        ("fill-ratios,r", po::value<std::string>()->default_value("0.1,0.3,0.5")->notifier(Config::validateFillRatios), "comma separated initial fill ratios (0.0-1.0)")
+        ("threads,t", po::value<std::string>()->default_value("1,2,4,8")->notifier(Config::validateThreadCounts), "comma separated update thread counts (1-64)")
+        ("min-time-ms", po::value<int>()->default_value(200), "minimal measured time per repetition")
+        ("repetitions", po::value<int>()->default_value(3), "repetitions per case, the fastest one is reported")
+        ("output,o", po::value<std::string>()->default_value(""), "write results as JSON to this file")
+        ("baseline,b", po::value<std::string>()->default_value(""), "compare against a JSON file written by an earlier run")
+        ("threshold", po::value<double>()->default_value(0.05)->notifier(Config::validateThreshold), "relative ns/cell slowdown that counts as a regression")
+        ("verify", po::bool_switch()->default_value(false), "check every engine against a naive reference simulation instead of timing them");
+}
+
+bool Config::parseCommandLine(int argc, char* argv[]) {
+    namespace po = boost::program_options;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, mDescription), mVariablesMap);
+        po::notify(mVariablesMap);
+    }
+    catch (const po::error& e) {
+        Print::PrintLine("Failed to parse command line arguments: " + std::string(e.what()));
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    if (mVariablesMap.count("help")) {
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    showCurrentConfig();
+    return true;
+}
+
+std::vector<int> Config::getGridSizes() const {
+    return parseList<int>(mVariablesMap["grid-sizes"].as<std::string>(), isValidGridSize).value_or(std::vector<int>{});
+}
+
+std::vector<float> Config::getFillRatios() const {
+    return parseList<float>(mVariablesMap["fill-ratios"].as<std::string>(), isValidFillRatio).value_or(std::vector<float>{});
+}
+
+std::vector<int> Config::getThreadCounts() const {
+    return parseList<int>(mVariablesMap["threads"].as<std::string>(), isValidThreadCount).value_or(std::vector<int>{});
+}
+
+int Config::getMinTimeMs() const {
+    return std::max(1, mVariablesMap["min-time-ms"].as<int>());
+}
+
+int Config::getRepetitions() const {
+    return std::max(1, mVariablesMap["repetitions"].as<int>());
+}
+
+const std::string& Config::getOutputFilename() const {
+    return mVariablesMap["output"].as<std::string>();
+}
+
+const std::string& Config::getBaselineFilename() const {
+    return mVariablesMap["baseline"].as<std::string>();
+}
+
+double Config::getThreshold() const {
+    return mVariablesMap["threshold"].as<double>();
+}
+
+bool Config::isVerifyMode() const {
+    return mVariablesMap["verify"].as<bool>();
+}
+
+void Config::validateGridSizes(const std::string& input) {
+    namespace po = boost::program_options;
+    if (!parseList<int>(input, isValidGridSize)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "grid-sizes", input);
+    }
+}
+
+void Config::validateFillRatios(const std::string& input) {
+    namespace po = boost::program_options;
+    if (!parseList<float>(input, isValidFillRatio)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "fill-ratios", input);
+    }
+}
+
+void Config::validateThreadCounts(const std::string& input) {
+    namespace po = boost::program_options;
+    if (!parseList<int>(input, isValidThreadCount)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "threads", input);
+    }
+}
+
+void Config::validateThreshold(double threshold) {
+    namespace po = boost::program_options;
+    if (threshold < 0.0) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "threshold", std::to_string(threshold));
+    }
+}
+
+void Config::showCurrentConfig() const {
+    if (isVerifyMode()) {
+        Print::PrintLine("\nVerifying the simulation engines against the naive reference");
+        return;
+    }
+    Print::PrintLine("\nSimulation Benchmark Configuration:");
+    Print::PrintLine("--------------------");
+    Print::PrintLine(Print::composeMessage("Grid sizes:", mVariablesMap["grid-sizes"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Fill ratios:", mVariablesMap["fill-ratios"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Threads:", mVariablesMap["threads"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Min time per repetition:", getMinTimeMs(), "ms"));
+    Print::PrintLine(Print::composeMessage("Repetitions:", getRepetitions()));
+    const auto& baseline = getBaselineFilename();
+    Print::PrintLine(Print::composeMessage("Baseline:", (baseline.empty() ? "none" : baseline + " (threshold " + std::to_string(getThreshold()) + ")")));
+    Print::PrintLine("--------------------");
+}
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <boost/program_options.hpp>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::SimulationBench {
+
+class Config
+{
+public:
+    Config();
+public:
+    bool parseCommandLine(int argc, char* argv[]);
+public:
+    std::vector<int> getGridSizes() const;
+    std::vector<float> getFillRatios() const;
+    std::vector<int> getThreadCounts() const;
+    int getMinTimeMs() const;
+    int getRepetitions() const;
+    const std::string& getOutputFilename() const;
+    const std::string& getBaselineFilename() const;
+    double getThreshold() const;
+    bool isVerifyMode() const;
+private:
+    void showCurrentConfig() const;
+private:
+    static void validateGridSizes(const std::string& input);
+    static void validateFillRatios(const std::string& input);
+    static void validateThreadCounts(const std::string& input);
+    static void validateThreshold(double threshold);
+private:
+    using VariablesMap = boost::program_options::variables_map;
+    using Description = boost::program_options::options_description;
+private:
+    VariablesMap mVariablesMap;
+    Description mDescription;
+};
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::SimulationBench {
+
+struct Measurement {
+    std::string name;
+    std::string operation;
+    int width = 0;
+    int height = 0;
+    float fillRatio = 0.0f;
+    int threadCount = 1;
+    uint64_t iterations = 0;
+    double nsPerCell = 0.0;
+    double cellsPerSecond = 0.0;
+};
+
+using Measurements = std::vector<Measurement>;
+
+} // namespace GameOfLife::SimulationBench
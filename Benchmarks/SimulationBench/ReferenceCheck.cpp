@@ -0,0 +1,170 @@
+#include "ReferenceCheck.h"
+#include "Print.h"
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+namespace GameOfLife::SimulationBench {
+
+namespace {
+    // The specialized kernels first, then generic rules with births outside survival, B0 and an empty survival set.
+    const std::array RULES {
+        std::string_view("B3/S23"), std::string_view("B36/S23"), std::string_view("B3678/S34678"),
+        std::string_view("B2/S"), std::string_view("B3/S012345678"), std::string_view("B3/S12345"),
+        std::string_view("B1357/S1357"), std::string_view("B0/S8"), std::string_view("B45/S")
+    };
+
+    // Odd widths and heights leave the Lookup engine a last column and row without a 2x2 partner.
+    const std::array SIZES { std::pair{ 10, 10 }, std::pair{ 33, 13 }, std::pair{ 17, 31 }, std::pair{ 64, 48 } };
+
+    const std::array THREAD_COUNTS { 1, 3 };
+
+    const int GENERATIONS = 6;
+
+    // Depth 1 falls back to update(), depths above the deepest pass run several passes.
+    const int MIN_TILED_DEPTH = 2;
+    const int MAX_TILED_DEPTH = 19;
+
+    // B0/S8 grows cells right at a dead edge, which the tiled bands must not carry inwards.
+    const std::array TILED_RULES { std::string_view("B3/S23"), std::string_view("B0/S8") };
+
+    // Small grids are narrower than any band and shorter than the deepest trapezoid; the
+    // wide one gets bands of 89-123 rows, so it is split at every depth.
+    const std::array TILED_SIZES { std::pair{ 33, 13 }, std::pair{ 17, 31 }, std::pair{ 2049, 257 } };
+
+    const float FILL_RATIO = 0.4f;
+
+    // Frames start with the WWWxHHH header, then one character per cell row by row.
+    const size_t FRAME_HEADER_LENGTH = 7;
+
+    const char* toString(::GameOfLife::Server::GameOfLife::Engine engine) {
+        using Engine = ::GameOfLife::Server::GameOfLife::Engine;
+        switch (engine) {
+        case Engine::Scalar:
+            return "scalar";
+        case Engine::Lookup:
+            return "lut";
+        case Engine::Tiled:
+            return "tiled";
+        }
+        return "unknown";
+    }
+}
+
+int ReferenceCheck::run() const {
+    int cases = 0;
+    int failures = 0;
+    for (auto ruleText : RULES) {
+        for (auto [width, height] : SIZES) {
+            for (auto boundary : { Simulation::Boundary::Torus, Simulation::Boundary::Dead }) {
+                for (int threadCount : THREAD_COUNTS) {
+                    const Case testCase{ *Rule::parse(ruleText), width, height, boundary, threadCount, static_cast<uint32_t>(cases) };
+                    for (auto engine : { Simulation::Engine::Scalar, Simulation::Engine::Lookup }) {
+                        ++cases;
+                        failures += checkEngine(testCase, engine) ? 0 : 1;
+                    }
+                }
+            }
+        }
+    }
+    for (auto ruleText : TILED_RULES) {
+        for (auto [width, height] : TILED_SIZES) {
+            for (auto boundary : { Simulation::Boundary::Torus, Simulation::Boundary::Dead }) {
+                for (int threadCount : THREAD_COUNTS) {
+                    const Case testCase{ *Rule::parse(ruleText), width, height, boundary, threadCount, static_cast<uint32_t>(cases) };
+                    ++cases;
+                    failures += checkTiled(testCase) ? 0 : 1;
+                }
+            }
+        }
+    }
+    Print::PrintLine(Print::composeMessage(cases - failures, "of", cases, "cases match"));
+    return failures;
+}
+
+bool ReferenceCheck::checkEngine(const Case& testCase, Simulation::Engine engine) const {
+    Simulation simulation(testCase.width, testCase.height, testCase.boundary, testCase.rule);
+    simulation.setEngine(engine);
+    simulation.setThreadCount(testCase.threadCount);
+    simulation.initializeRandom(FILL_RATIO, testCase.seed);
+
+    Cells reference = readCells(simulation, testCase);
+    for (int generation = 1; generation <= GENERATIONS; ++generation) {
+        simulation.update();
+        reference = stepReference(reference, testCase);
+        if (readCells(simulation, testCase) != reference) {
+            Print::PrintLine(Print::composeMessage("Mismatch:", toString(engine), describe(testCase), "at generation", generation));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReferenceCheck::checkTiled(const Case& testCase) const {
+    Simulation scalar(testCase.width, testCase.height, testCase.boundary, testCase.rule);
+    Simulation tiled(testCase.width, testCase.height, testCase.boundary, testCase.rule);
+    tiled.setEngine(Simulation::Engine::Tiled);
+    for (Simulation* simulation : { &scalar, &tiled }) {
+        simulation->setThreadCount(testCase.threadCount);
+        simulation->initializeRandom(FILL_RATIO, testCase.seed);
+    }
+
+    for (int depth = MIN_TILED_DEPTH; depth <= MAX_TILED_DEPTH; ++depth) {
+        scalar.advance(depth);
+        tiled.advance(depth);
+        if (tiled.toString() != scalar.toString()) {
+            Print::PrintLine(Print::composeMessage("Mismatch: tiled", describe(testCase), "against scalar at depth", depth));
+            return false;
+        }
+    }
+    return true;
+}
+
+ReferenceCheck::Cells ReferenceCheck::readCells(const Simulation& simulation, const Case& testCase) {
+    const std::string frame = simulation.toString();
+    Cells cells(static_cast<size_t>(testCase.width) * testCase.height);
+    for (size_t cell = 0; cell < cells.size(); ++cell) {
+        cells[cell] = frame[FRAME_HEADER_LENGTH + cell] == '#';
+    }
+    return cells;
+}
+
+ReferenceCheck::Cells ReferenceCheck::stepReference(const Cells& cells, const Case& testCase) {
+    const int width = testCase.width;
+    const int height = testCase.height;
+    auto isAlive = [&](int x, int y) -> int {
+        if (testCase.boundary == Simulation::Boundary::Torus) {
+            x = (x + width) % width;
+            y = (y + height) % height;
+        }
+        else if (x < 0 || x >= width || y < 0 || y >= height) {
+            return 0;
+        }
+        return cells[static_cast<size_t>(y) * width + x];
+    };
+
+    Cells next(cells.size());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int neighbors = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx != 0 || dy != 0) {
+                        neighbors += isAlive(x + dx, y + dy);
+                    }
+                }
+            }
+            const uint16_t mask = isAlive(x, y) ? testCase.rule.survival : testCase.rule.birth;
+            next[static_cast<size_t>(y) * width + x] = (mask >> neighbors) & 1;
+        }
+    }
+    return next;
+}
+
+std::string ReferenceCheck::describe(const Case& testCase) {
+    return Print::composeMessage(testCase.rule.toString(), std::to_string(testCase.width) + "x" + std::to_string(testCase.height),
+                                 (testCase.boundary == Simulation::Boundary::Torus ? "torus" : "dead"), testCase.threadCount, "threads");
+}
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "GameOfLife.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::SimulationBench {
+
+// Steps the simulation engines next to a deliberately naive model of the rule, one
+// plain grid of cells with modular or bounds-checked neighbor reads, and compares
+// every generation. Cases cover the rules with specialized kernels and a few generic
+// ones, odd grid sizes, both boundaries and several band threads. The Tiled engine
+// is compared against the scalar one instead, over every temporal depth it supports
+// and on a grid wide enough to be split into several bands.
+class ReferenceCheck {
+public:
+    // Prints every mismatching case and returns how many there were.
+    int run() const;
+private:
+    using Simulation = ::GameOfLife::Server::GameOfLife;
+    using Rule = ::GameOfLife::Server::Rule;
+    using Cells = std::vector<uint8_t>;
+
+    struct Case {
+        Rule rule;
+        int width;
+        int height;
+        Simulation::Boundary boundary;
+        int threadCount;
+        uint32_t seed;
+    };
+private:
+    bool checkEngine(const Case& testCase, Simulation::Engine engine) const;
+    bool checkTiled(const Case& testCase) const;
+    static Cells readCells(const Simulation& simulation, const Case& testCase);
+    static Cells stepReference(const Cells& cells, const Case& testCase);
+    static std::string describe(const Case& testCase);
+};
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,108 @@
+#include "SimulationBenchmark.h"
+#include "GameOfLife.h"
+#include "Print.h"
+
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace GameOfLife::SimulationBench {
+
+namespace {
+    // Keeps the optimizer from discarding results that are otherwise unused.
+    volatile size_t gSink = 0;
+
+    // Generations per iteration of the advance cases, deep enough for one full tiled pass.
+    const int TEMPORAL_GENERATIONS = 8;
+}
+
+SimulationBenchmark::SimulationBenchmark(int minTimeMs, int repetitions)
+    : mMinTime(minTimeMs)
+    , mRepetitions(repetitions)
+{
+}
+
+Measurements SimulationBenchmark::run(const std::vector<int>& gridSizes, const std::vector<float>& fillRatios, const std::vector<int>& threadCounts) {
+    using Simulation = ::GameOfLife::Server::GameOfLife;
+    Measurements measurements;
+    for (int size : gridSizes) {
+        for (float fillRatio : fillRatios) {
+            Simulation simulation(size, size);
+            auto seed = [&simulation, fillRatio]() { simulation.initializeRandom(fillRatio); };
+
+            measurements.push_back(measure("initializeRandom", size, fillRatio, 1, []() {}, seed));
+            measurements.push_back(measure("toString", size, fillRatio, 1, seed, [&simulation]() {
+                gSink = gSink + simulation.toString().size();
+            }));
+            for (int threadCount : threadCounts) {
+                simulation.setThreadCount(threadCount);
+                simulation.setEngine(Simulation::Engine::Scalar);
+                measurements.push_back(measure("update", size, fillRatio, threadCount, seed, [&simulation]() {
+                    simulation.update();
+                }));
+                simulation.setEngine(Simulation::Engine::Lookup);
+                measurements.push_back(measure("update-lut", size, fillRatio, threadCount, seed, [&simulation]() {
+                    simulation.update();
+                }));
+                // ns/cell of these two covers all TEMPORAL_GENERATIONS generations of an iteration.
+                simulation.setEngine(Simulation::Engine::Scalar);
+                measurements.push_back(measure("advance8", size, fillRatio, threadCount, seed, [&simulation]() {
+                    simulation.advance(TEMPORAL_GENERATIONS);
+                }));
+                simulation.setEngine(Simulation::Engine::Tiled);
+                measurements.push_back(measure("advance8-tiled", size, fillRatio, threadCount, seed, [&simulation]() {
+                    simulation.advance(TEMPORAL_GENERATIONS);
+                }));
+            }
+        }
+    }
+    return measurements;
+}
+
+Measurement SimulationBenchmark::measure(const std::string& operation, int size, float fillRatio, int threadCount, const Setup& setup, const Operation& body) const {
+    using Clock = std::chrono::steady_clock;
+    const double cells = static_cast<double>(size) * size;
+
+    Measurement measurement;
+    measurement.name = composeName(operation, size, fillRatio, threadCount);
+    measurement.operation = operation;
+    measurement.width = size;
+    measurement.height = size;
+    measurement.fillRatio = fillRatio;
+    measurement.threadCount = threadCount;
+    measurement.nsPerCell = std::numeric_limits<double>::max();
+
+    for (int repetition = 0; repetition < mRepetitions; ++repetition) {
+        setup();
+        uint64_t iterations = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        do {
+            body();
+            ++iterations;
+            elapsed = Clock::now() - start;
+        } while (elapsed < mMinTime);
+
+        const double nsPerCell = std::chrono::duration<double, std::nano>(elapsed).count() / (iterations * cells);
+        if (nsPerCell < measurement.nsPerCell) {
+            measurement.nsPerCell = nsPerCell;
+            measurement.iterations = iterations;
+        }
+    }
+    measurement.cellsPerSecond = 1e9 / measurement.nsPerCell;
+
+    std::ostringstream line;
+    line << std::left << std::setw(44) << measurement.name << std::right << std::fixed
+         << std::setprecision(3) << std::setw(10) << measurement.nsPerCell << " ns/cell"
+         << std::setprecision(0) << std::setw(16) << measurement.cellsPerSecond << " cells/s";
+    Print::PrintLine(line.str());
+    return measurement;
+}
+
+std::string SimulationBenchmark::composeName(const std::string& operation, int size, float fillRatio, int threadCount) {
+    std::ostringstream oss;
+    oss << operation << '/' << size << 'x' << size << "/fill=" << std::fixed << std::setprecision(2) << fillRatio << "/threads=" << threadCount;
+    return oss.str();
+}
+
+} // namespace GameOfLife::SimulationBench
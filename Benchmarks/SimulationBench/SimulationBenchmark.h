@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Measurement.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::SimulationBench {
+
+// Times the simulation entry points on square grids. Every case is repeated a few
+// times from a freshly seeded grid and the fastest repetition is kept, which filters
+// out most of the scheduling noise.
+class SimulationBenchmark {
+public:
+    SimulationBenchmark(int minTimeMs, int repetitions);
+public:
+    Measurements run(const std::vector<int>& gridSizes, const std::vector<float>& fillRatios, const std::vector<int>& threadCounts);
+private:
+    using Setup = std::function<void()>;
+    using Operation = std::function<void()>;
+private:
+    Measurement measure(const std::string& operation, int size, float fillRatio, int threadCount, const Setup& setup, const Operation& body) const;
+    static std::string composeName(const std::string& operation, int size, float fillRatio, int threadCount);
+private:
+    std::chrono::milliseconds mMinTime;
+    int mRepetitions;
+};
+
+} // namespace GameOfLife::SimulationBench
@@ -0,0 +1,55 @@
+#include "Config.h"
+#include "SimulationBenchmark.h"
+#include "BenchmarkReport.h"
+#include "ReferenceCheck.h"
+#include "Log.h"
+
+#include <iostream>
+
+namespace {
+    // Exit codes: 0 success, 1 usage or I/O error, 2 regression against the baseline,
+    // 3 an engine that disagrees with the reference simulation.
+    const int EXIT_REGRESSION = 2;
+    const int EXIT_MISMATCH = 3;
+}
+
+int main(int argc, char* argv[]) {
+    using namespace GameOfLife::SimulationBench;
+    try {
+        Config config;
+        if (!config.parseCommandLine(argc, argv)) {
+            return 1;
+        }
+        Log::initConsoleLogger(LogLevel::Warning);
+
+        if (config.isVerifyMode()) {
+            const int failures = ReferenceCheck().run();
+            Log::destroyLogger();
+            return failures > 0 ? EXIT_MISMATCH : 0;
+        }
+
+        std::optional<Measurements> baseline;
+        if (!config.getBaselineFilename().empty()) {
+            baseline = BenchmarkReport::read(config.getBaselineFilename());
+            if (!baseline) {
+                return 1;
+            }
+        }
+
+        SimulationBenchmark benchmark(config.getMinTimeMs(), config.getRepetitions());
+        auto measurements = benchmark.run(config.getGridSizes(), config.getFillRatios(), config.getThreadCounts());
+
+        if (!config.getOutputFilename().empty() && !BenchmarkReport::write(measurements, config.getOutputFilename())) {
+            return 1;
+        }
+        if (baseline && BenchmarkReport::compare(measurements, *baseline, config.getThreshold()) > 0) {
+            return EXIT_REGRESSION;
+        }
+        Log::destroyLogger();
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unhandled exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,57 @@
+#include "BenchFrame.h"
+
+#include <charconv>
+#include <chrono>
+
+namespace GameOfLife::StreamingBench {
+
+namespace {
+    const char SEQUENCE_SEPARATOR = ':';
+    const char HEADER_TERMINATOR = '|';
+    const char PADDING = '.';
+    const char FRAME_DELIMITER = '\n';
+}
+
+std::string BenchFrame::compose(Kind kind, uint64_t sequence, size_t frameSize) {
+    std::string frame;
+    frame.reserve(frameSize);
+    frame += static_cast<char>(kind);
+    frame += std::to_string(sequence);
+    frame += SEQUENCE_SEPARATOR;
+    frame += std::to_string(now());
+    frame += HEADER_TERMINATOR;
+    if (frame.size() + 1 < frameSize) {
+        frame.append(frameSize - frame.size() - 1, PADDING);
+    }
+    frame += FRAME_DELIMITER;
+    return frame;
+}
+
+std::optional<BenchFrame::Header> BenchFrame::parse(const std::string& frame) {
+    if (frame.empty()) {
+        return std::nullopt;
+    }
+    const char kind = frame[0];
+    if (kind != static_cast<char>(Kind::Warmup) && kind != static_cast<char>(Kind::Measured) && kind != static_cast<char>(Kind::End)) {
+        return std::nullopt;
+    }
+
+    Header header{ static_cast<Kind>(kind), 0, 0 };
+    const char* end = frame.data() + frame.size();
+    auto sequenceResult = std::from_chars(frame.data() + 1, end, header.sequence);
+    if (sequenceResult.ec != std::errc() || sequenceResult.ptr == end || *sequenceResult.ptr != SEQUENCE_SEPARATOR) {
+        return std::nullopt;
+    }
+    auto timeResult = std::from_chars(sequenceResult.ptr + 1, end, header.sentNs);
+    if (timeResult.ec != std::errc() || timeResult.ptr == end || *timeResult.ptr != HEADER_TERMINATOR) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+uint64_t BenchFrame::now() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace GameOfLife::StreamingBench
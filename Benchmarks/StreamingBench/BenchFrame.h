@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace GameOfLife::StreamingBench {
+
+// Synthetic frame pushed through the transports: "<kind><sequence>:<sent ns>|" padded to
+// the requested size and terminated with the usual frame delimiter. The send time comes
+// from steady_clock, which is shared by forked processes on the same host.
+class BenchFrame {
+public:
+    enum class Kind : char {
+        Warmup = 'W',
+        Measured = 'M',
+        End = 'E'
+    };
+    struct Header {
+        Kind kind;
+        uint64_t sequence;
+        uint64_t sentNs;
+    };
+public:
+    static std::string compose(Kind kind, uint64_t sequence, size_t frameSize);
+    static std::optional<Header> parse(const std::string& frame);
+    static uint64_t now();
+};
+
+} // namespace GameOfLife::StreamingBench
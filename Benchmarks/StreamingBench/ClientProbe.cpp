@@ -0,0 +1,109 @@
+#include "ClientProbe.h"
+#include "BenchFrame.h"
+
+#include <sstream>
+
+namespace GameOfLife::StreamingBench {
+
+void ClientProbe::Result::merge(const Result& other) {
+    received += other.received;
+    gaps += other.gaps;
+    reordered += other.reordered;
+    corrupted += other.corrupted;
+    latency.merge(other.latency);
+}
+
+std::string ClientProbe::Result::serialize() const {
+    std::ostringstream oss;
+    oss << received << ' ' << gaps << ' ' << reordered << ' ' << corrupted << '\n' << latency.serialize();
+    return oss.str();
+}
+
+std::optional<ClientProbe::Result> ClientProbe::Result::deserialize(const std::string& data) {
+    Result result;
+    std::istringstream iss(data);
+    std::string histogram;
+    if (!(iss >> result.received >> result.gaps >> result.reordered >> result.corrupted) || !std::getline(iss >> std::ws, histogram)) {
+        return std::nullopt;
+    }
+    auto latency = Histogram::deserialize(histogram);
+    if (!latency) {
+        return std::nullopt;
+    }
+    result.latency = std::move(*latency);
+    return result;
+}
+
+ClientProbe::ClientProbe(Streaming::ClientPtr client, size_t frameSize)
+    : mClient(std::move(client))
+    , mFrameSize(frameSize)
+    , mReady(false)
+    , mFinished(false)
+{
+    mClient->setOnDataReceived([this](const std::string& frame) { onFrame(frame); });
+}
+
+ClientProbe::~ClientProbe() {
+    disconnect();
+}
+
+bool ClientProbe::connect(const std::string& address, int port) {
+    return mClient->connect(address, port);
+}
+
+void ClientProbe::disconnect() {
+    if (mClient->isConnected()) {
+        mClient->disconnect();
+    }
+}
+
+bool ClientProbe::isReady() const {
+    return mReady;
+}
+
+bool ClientProbe::isFinished() const {
+    return mFinished;
+}
+
+ClientProbe::Result ClientProbe::getResult() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mResult;
+}
+
+void ClientProbe::onFrame(const std::string& frame) {
+    const uint64_t receivedNs = BenchFrame::now();
+    auto header = BenchFrame::parse(frame);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!header) {
+        ++mResult.corrupted;
+        return;
+    }
+    switch (header->kind) {
+    case BenchFrame::Kind::Warmup:
+        mReady = true;
+        return;
+    case BenchFrame::Kind::End:
+        mFinished = true;
+        return;
+    case BenchFrame::Kind::Measured:
+        break;
+    }
+
+    // Transports hand frames over without the trailing delimiter.
+    if (frame.size() + 1 != mFrameSize) {
+        ++mResult.corrupted;
+    }
+    ++mResult.received;
+    mResult.latency.record(receivedNs > header->sentNs ? receivedNs - header->sentNs : 0);
+    if (mLastSequence && header->sequence <= *mLastSequence) {
+        ++mResult.reordered;
+        return;
+    }
+    if (mLastSequence && header->sequence > *mLastSequence + 1) {
+        mResult.gaps += header->sequence - *mLastSequence - 1;
+    }
+    mLastSequence = header->sequence;
+}
+
+} // namespace GameOfLife::StreamingBench
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IClient.h"
+#include "Histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace GameOfLife::StreamingBench {
+
+// Wraps one streaming client and measures what arrives: end-to-end latency of measured
+// frames, sequence gaps and reordering, and frames of the wrong size.
+class ClientProbe {
+public:
+    struct Result {
+        uint64_t received = 0;
+        uint64_t gaps = 0;
+        uint64_t reordered = 0;
+        uint64_t corrupted = 0;
+        Histogram latency;
+    public:
+        void merge(const Result& other);
+        std::string serialize() const;
+        static std::optional<Result> deserialize(const std::string& data);
+    };
+public:
+    ClientProbe(Streaming::ClientPtr client, size_t frameSize);
+    ~ClientProbe();
+public:
+    bool connect(const std::string& address, int port);
+    void disconnect();
+    bool isReady() const;
+    bool isFinished() const;
+    Result getResult() const;
+private:
+    void onFrame(const std::string& frame);
+private:
+    using AtomicFlag = std::atomic<bool>;
+private:
+    Streaming::ClientPtr mClient;
+    size_t mFrameSize;
+    Result mResult;
+    std::optional<uint64_t> mLastSequence;
+    mutable std::mutex mMutex;
+    AtomicFlag mReady;
+    AtomicFlag mFinished;
+};
+
+} // namespace GameOfLife::StreamingBench
@@ -0,0 +1,182 @@
+#include "Config.h"
+#include "StreamingFactory.h"
+#include "Utils.h"
+
+#include <map>
+#include <optional>
+#include <regex>
+#include <sstream>
+
+namespace GameOfLife::StreamingBench {
+
+namespace {
+    const std::map<std::string, LogLevel> logLevelMap {
+        {"throw", LogLevel::Throw},
+        {"error", LogLevel::Error},
+        {"warning", LogLevel::Warning},
+        {"info", LogLevel::Info},
+        {"debug", LogLevel::Debug},
+        {"trace", LogLevel::Trace}
+    };
+
+    // Multicast transports need a group address, everything else listens on loopback.
+    const std::map<std::string, std::string> defaultAddressMap {
+        {"asio", "239.255.0.1"},
+        {"poco", "239.255.0.1"}
+    };
+    const char* LOOPBACK_ADDRESS = "127.0.0.1";
+
+    std::string composeDefaultTransports() {
+        std::string transports;
+        for (const auto& transport : Streaming::StreamingFactory::GetTransports()) {
+            transports += (transports.empty() ? "" : ",") + transport;
+        }
+        return transports;
+    }
+
+    // Transport list format: name[@address],name[@address],...
+    std::optional<std::vector<TransportTarget>> parseTransports(const std::string& input) {
+        std::vector<TransportTarget> transports;
+        std::regex transportRegex("([a-z-]+)(?:@(.+))?");
+        std::istringstream iss(input);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            std::smatch matches;
+            if (!std::regex_match(item, matches, transportRegex)) {
+                return std::nullopt;
+            }
+            std::string name = matches[1];
+            std::string address = matches[2];
+            if (address.empty()) {
+                auto it = defaultAddressMap.find(name);
+                address = it != defaultAddressMap.end() ? it->second : LOOPBACK_ADDRESS;
+            }
+            transports.push_back({ name, address });
+        }
+        if (transports.empty()) {
+            return std::nullopt;
+        }
+        return transports;
+    }
+}
+
+Config::Config()
+    : mDescription("Streaming Loopback Benchmark Options") {
+    namespace po = boost::program_options;
+    mDescription.add_options()
+        ("help,h", "produce help message")
+        ("log-level,l", po::value<std::string>()->default_value("warning")->notifier(Config::validateLogLevel), "logging level: throw/error/warning/info/debug/trace")
+        ("transport,T", po::value<std::string>()->default_value(composeDefaultTransports())->notifier(Config::validateTransports), "comma separated transports to measure as name[@address]")
+        ("port,p", po::value<int>()->default_value(9500)->notifier([](int value) { validatePositive("port", value); }), "first port, each transport gets the next one")
+        ("clients,c", po::value<int>()->default_value(8)->notifier([](int value) { validatePositive("clients", value); }), "number of clients")
+        ("fork", po::bool_switch()->default_value(false), "run every client in its own forked process")
+        ("frames,n", po::value<int>()->default_value(1000)->notifier([](int value) { validatePositive("frames", value); }), "number of measured frames")
+        ("rate,r", po::value<int>()->default_value(100), "frames per second, 0 sends as fast as possible")
+        ("frame-size,s", po::value<int>()->default_value(1024)->notifier([](int value) { validatePositive("frame-size", value); }), "frame size in bytes including the delimiter")
+        ("threads,t", po::value<int>()->default_value(2)->notifier([](int value) { validatePositive("threads", value); }), "server thread count")
+        ("drain-ms", po::value<int>()->default_value(500), "time to wait for in-flight frames after the last send");
+}
+
+bool Config::parseCommandLine(int argc, char* argv[]) {
+    namespace po = boost::program_options;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, mDescription), mVariablesMap);
+        po::notify(mVariablesMap);
+    }
+    catch (const po::error& e) {
+        Print::PrintLine("Failed to parse command line arguments: " + std::string(e.what()));
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    if (mVariablesMap.count("help")) {
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    showCurrentConfig();
+    return true;
+}
+
+LogLevel Config::getLogLevel() const {
+    return logLevelMap.at(mVariablesMap["log-level"].as<std::string>());
+}
+
+std::vector<TransportTarget> Config::getTransports() const {
+    return parseTransports(mVariablesMap["transport"].as<std::string>()).value_or(std::vector<TransportTarget>{});
+}
+
+int Config::getPort() const {
+    return mVariablesMap["port"].as<int>();
+}
+
+int Config::getClientCount() const {
+    return mVariablesMap["clients"].as<int>();
+}
+
+bool Config::getForkClients() const {
+    return mVariablesMap["fork"].as<bool>();
+}
+
+int Config::getFrameCount() const {
+    return mVariablesMap["frames"].as<int>();
+}
+
+int Config::getRate() const {
+    return mVariablesMap["rate"].as<int>();
+}
+
+int Config::getFrameSize() const {
+    return mVariablesMap["frame-size"].as<int>();
+}
+
+int Config::getThreadCount() const {
+    return mVariablesMap["threads"].as<int>();
+}
+
+int Config::getDrainMs() const {
+    return mVariablesMap["drain-ms"].as<int>();
+}
+
+void Config::validateLogLevel(const std::string& input) {
+    namespace po = boost::program_options;
+    if (logLevelMap.find(input) == logLevelMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "log-level", input);
+    }
+}
+
+void Config::validateTransports(const std::string& input) {
+    namespace po = boost::program_options;
+    auto transports = parseTransports(input);
+    if (!transports) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "transport", input);
+    }
+    for (const auto& transport : *transports) {
+        if (!Streaming::StreamingFactory::HasTransport(transport.name)) {
+            throw po::validation_error(po::validation_error::invalid_option_value, "transport", input);
+        }
+    }
+}
+
+void Config::validatePositive(const std::string& option, int value) {
+    namespace po = boost::program_options;
+    if (value < 1 || (option == "port" && !isValidPort(value))) {
+        throw po::validation_error(po::validation_error::invalid_option_value, option, std::to_string(value));
+    }
+}
+
+void Config::showCurrentConfig() const {
+    Print::PrintLine("\nStreaming Benchmark Configuration:");
+    Print::PrintLine("--------------------");
+    Print::PrintLine(Print::composeMessage("Transports:", mVariablesMap["transport"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("First port:", getPort()));
+    Print::PrintLine(Print::composeMessage("Clients:", getClientCount(), (getForkClients() ? "(forked)" : "(in-process)")));
+    Print::PrintLine(Print::composeMessage("Frames:", getFrameCount()));
+    Print::PrintLine(Print::composeMessage("Rate:", (getRate() > 0 ? std::to_string(getRate()) + " fps" : "unthrottled")));
+    Print::PrintLine(Print::composeMessage("Frame size:", getFrameSize(), "bytes"));
+    Print::PrintLine(Print::composeMessage("Server threads:", getThreadCount()));
+    Print::PrintLine("--------------------");
+}
+
+} // namespace GameOfLife::StreamingBench
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Log.h"
+#include <boost/program_options.hpp>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::StreamingBench {
+
+struct TransportTarget {
+    std::string name;
+    std::string address;
+};
+
+class Config
+{
+public:
+    Config();
+public:
+    bool parseCommandLine(int argc, char* argv[]);
+public:
+    LogLevel getLogLevel() const;
+    std::vector<TransportTarget> getTransports() const;
+    int getPort() const;
+    int getClientCount() const;
+    bool getForkClients() const;
+    int getFrameCount() const;
+    int getRate() const;
+    int getFrameSize() const;
+    int getThreadCount() const;
+    int getDrainMs() const;
+private:
+    void showCurrentConfig() const;
+private:
+    static void validateLogLevel(const std::string& input);
+    static void validateTransports(const std::string& input);
+    static void validatePositive(const std::string& option, int value);
+private:
+    using VariablesMap = boost::program_options::variables_map;
+    using Description = boost::program_options::options_description;
+private:
+    VariablesMap mVariablesMap;
+    Description mDescription;
+};
+
+} // namespace GameOfLife::StreamingBench
@@ -0,0 +1,312 @@
+#include "LoopbackBenchmark.h"
+#include "BenchFrame.h"
+#include "StreamingFactory.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace GameOfLife::StreamingBench {
+
+namespace {
+    const char READY_MARKER = 'R';
+    const auto CONNECT_TIMEOUT = std::chrono::seconds(10);
+    const auto CONNECT_RETRY_INTERVAL = std::chrono::milliseconds(50);
+    const auto WARMUP_TIMEOUT = std::chrono::seconds(10);
+    const auto WARMUP_INTERVAL = std::chrono::milliseconds(20);
+    const auto FINISH_TIMEOUT = std::chrono::seconds(5);
+    const int END_FRAME_REPEATS = 5;
+
+    double getCpuSeconds(int who) {
+        rusage usage{};
+        getrusage(who, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+
+    double toMicroseconds(uint64_t nanoseconds) {
+        return nanoseconds / 1000.0;
+    }
+}
+
+LoopbackBenchmark::LoopbackBenchmark(const Settings& settings)
+    : mSettings(settings)
+{
+}
+
+LoopbackBenchmark::~LoopbackBenchmark() {
+    mProbes.clear();
+    for (auto& client : mForkedClients) {
+        if (client.readFd >= 0) {
+            close(client.readFd);
+        }
+        if (client.pid > 0) {
+            kill(client.pid, SIGKILL);
+            waitpid(client.pid, nullptr, 0);
+        }
+    }
+}
+
+std::optional<LoopbackBenchmark::Report> LoopbackBenchmark::run() {
+    Report report;
+    report.transport = mSettings.transport;
+    report.clientCount = mSettings.clientCount;
+
+    // Clients are forked before this run's server starts and keep retrying until it listens.
+    // A child gets no copy of the log writer thread, so the parent stops it around the
+    // forks and every process starts its own.
+    if (mSettings.forkClients) {
+        Log::destroyLogger();
+        const bool forked = forkClients();
+        Log::initConsoleLogger(mSettings.logLevel);
+        if (!forked) {
+            return std::nullopt;
+        }
+    }
+
+    auto server = Streaming::StreamingFactory::CreateServer(mSettings.transport);
+    if (!server->start(mSettings.address, mSettings.port, mSettings.threadCount)) {
+        Log::Error(Print::composeMessage("Failed to start", mSettings.transport, "server"));
+        return std::nullopt;
+    }
+
+    bool completed = (mSettings.forkClients || startInProcessClients()) && warmUp(*server);
+    if (completed) {
+        sendMeasuredFrames(*server, report);
+        finish(*server, report);
+        completed = !mSettings.forkClients || collectForkedResults(report);
+    }
+
+    mProbes.clear();
+    server->stop();
+    if (!completed) {
+        return std::nullopt;
+    }
+    return report;
+}
+
+bool LoopbackBenchmark::startInProcessClients() {
+    for (int i = 0; i < mSettings.clientCount; ++i) {
+        auto probe = std::make_unique<ClientProbe>(Streaming::StreamingFactory::CreateClient(mSettings.transport), mSettings.frameSize);
+        if (!probe->connect(mSettings.address, mSettings.port)) {
+            Log::Error(Print::composeMessage("Client", i, "failed to connect to", mSettings.transport));
+            return false;
+        }
+        mProbes.push_back(std::move(probe));
+    }
+    return true;
+}
+
+bool LoopbackBenchmark::forkClients() {
+    for (int i = 0; i < mSettings.clientCount; ++i) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            Log::Error("Failed to create a pipe for a forked client");
+            return false;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            Log::Error("Failed to fork a client process");
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            for (const auto& client : mForkedClients) {
+                close(client.readFd);
+            }
+            runForkedClient(fds[1]);
+        }
+        close(fds[1]);
+        mForkedClients.push_back({ pid, fds[0] });
+    }
+    mForkedReady.assign(mForkedClients.size(), false);
+    return true;
+}
+
+void LoopbackBenchmark::runForkedClient(int writeFd) {
+    Log::initConsoleLogger(mSettings.logLevel);
+    const auto deadline = std::chrono::steady_clock::now() + CONNECT_TIMEOUT;
+    auto probe = std::make_unique<ClientProbe>(Streaming::StreamingFactory::CreateClient(mSettings.transport), mSettings.frameSize);
+    while (!probe->connect(mSettings.address, mSettings.port)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            _exit(1);
+        }
+        std::this_thread::sleep_for(CONNECT_RETRY_INTERVAL);
+    }
+
+    while (!probe->isReady()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (write(writeFd, &READY_MARKER, 1) != 1) {
+        _exit(1);
+    }
+
+    // The parent kills stragglers, so waiting for the end frame needs no timeout of its own.
+    while (!probe->isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const std::string result = probe->getResult().serialize();
+    probe.reset();
+
+    size_t written = 0;
+    while (written < result.size()) {
+        ssize_t count = write(writeFd, result.data() + written, result.size() - written);
+        if (count <= 0) {
+            _exit(1);
+        }
+        written += static_cast<size_t>(count);
+    }
+    close(writeFd);
+    Log::destroyLogger();
+    _exit(0);
+}
+
+bool LoopbackBenchmark::warmUp(Streaming::IServer& server) {
+    const auto deadline = std::chrono::steady_clock::now() + WARMUP_TIMEOUT;
+    uint64_t sequence = 0;
+    while (countReadyClients() < mSettings.clientCount) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            Log::Error(Print::composeMessage("Only", countReadyClients(), "of", mSettings.clientCount, "clients became ready on", mSettings.transport));
+            return false;
+        }
+        server.broadcastData(BenchFrame::compose(BenchFrame::Kind::Warmup, sequence++, mSettings.frameSize));
+        std::this_thread::sleep_for(WARMUP_INTERVAL);
+    }
+    return true;
+}
+
+int LoopbackBenchmark::countReadyClients() {
+    int ready = 0;
+    for (const auto& probe : mProbes) {
+        ready += probe->isReady() ? 1 : 0;
+    }
+    for (size_t i = 0; i < mForkedClients.size(); ++i) {
+        if (!mForkedReady[i]) {
+            pollfd descriptor{ mForkedClients[i].readFd, POLLIN, 0 };
+            char marker = 0;
+            if (poll(&descriptor, 1, 0) > 0 && read(mForkedClients[i].readFd, &marker, 1) == 1 && marker == READY_MARKER) {
+                mForkedReady[i] = true;
+            }
+        }
+        ready += mForkedReady[i] ? 1 : 0;
+    }
+    return ready;
+}
+
+void LoopbackBenchmark::sendMeasuredFrames(Streaming::IServer& server, Report& report) {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = mSettings.rate > 0 ? std::chrono::nanoseconds(1000000000LL / mSettings.rate) : std::chrono::nanoseconds(0);
+    const double cpuStart = getCpuSeconds(RUSAGE_SELF);
+    const auto start = Clock::now();
+
+    auto nextSend = start;
+    for (int i = 0; i < mSettings.frameCount; ++i) {
+        if (interval.count() > 0) {
+            std::this_thread::sleep_until(nextSend);
+            nextSend += interval;
+        }
+        server.broadcastData(BenchFrame::compose(BenchFrame::Kind::Measured, static_cast<uint64_t>(i), mSettings.frameSize));
+        ++report.sent;
+    }
+
+    report.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(mSettings.drainMs));
+    report.serverCpuSeconds = getCpuSeconds(RUSAGE_SELF) - cpuStart;
+}
+
+void LoopbackBenchmark::finish(Streaming::IServer& server, Report& report) {
+    // Datagram transports may lose the end marker, so it is repeated a few times.
+    for (int i = 0; i < END_FRAME_REPEATS; ++i) {
+        server.broadcastData(BenchFrame::compose(BenchFrame::Kind::End, 0, mSettings.frameSize));
+        std::this_thread::sleep_for(WARMUP_INTERVAL);
+    }
+    for (const auto& probe : mProbes) {
+        addClientResult(probe->getResult(), report);
+    }
+}
+
+bool LoopbackBenchmark::collectForkedResults(Report& report) {
+    const auto deadline = std::chrono::steady_clock::now() + FINISH_TIMEOUT;
+    for (auto& client : mForkedClients) {
+        std::string data;
+        char buffer[4096];
+        while (true) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            pollfd descriptor{ client.readFd, POLLIN, 0 };
+            if (remaining.count() <= 0 || poll(&descriptor, 1, static_cast<int>(remaining.count())) <= 0) {
+                break;
+            }
+            ssize_t count = read(client.readFd, buffer, sizeof(buffer));
+            if (count <= 0) {
+                break;
+            }
+            data.append(buffer, static_cast<size_t>(count));
+        }
+        close(client.readFd);
+        client.readFd = -1;
+
+        auto result = ClientProbe::Result::deserialize(data);
+        if (!result) {
+            Log::Error(Print::composeMessage("Forked client", client.pid, "did not report its results"));
+            return false;
+        }
+        addClientResult(*result, report);
+
+        int status = 0;
+        rusage usage{};
+        if (wait4(client.pid, &status, 0, &usage) == client.pid) {
+            report.clientCpuSeconds += usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+        }
+        client.pid = -1;
+    }
+    return true;
+}
+
+void LoopbackBenchmark::addClientResult(const ClientProbe::Result& result, Report& report) const {
+    if (result.received < report.sent) {
+        ++report.clientsWithDrops;
+    }
+    report.clients.merge(result);
+}
+
+void LoopbackBenchmark::printHeader() {
+    std::ostringstream oss;
+    oss << std::left << std::setw(16) << "transport" << std::right
+        << std::setw(8) << "clients" << std::setw(9) << "sent" << std::setw(10) << "fps" << std::setw(10) << "MB/s"
+        << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(10) << "p999 us" << std::setw(10) << "max us"
+        << std::setw(10) << "dropped" << std::setw(8) << "slow" << std::setw(10) << "corrupt" << std::setw(14) << "cpu us/frame";
+    Print::PrintLine(oss.str());
+}
+
+void LoopbackBenchmark::printReport(const Report& report, size_t frameSize) {
+    const auto& latency = report.clients.latency;
+    const uint64_t expected = report.sent * static_cast<uint64_t>(report.clientCount);
+    const uint64_t dropped = expected > report.clients.received ? expected - report.clients.received : 0;
+    const double elapsed = report.elapsedSeconds > 0 ? report.elapsedSeconds : 1;
+    const double cpuPerFrame = report.sent > 0 ? (report.serverCpuSeconds + report.clientCpuSeconds) * 1e6 / report.sent : 0;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1)
+        << std::left << std::setw(16) << report.transport << std::right
+        << std::setw(8) << report.clientCount << std::setw(9) << report.sent
+        << std::setw(10) << report.sent / elapsed
+        << std::setw(10) << report.clients.received * frameSize / elapsed / (1024 * 1024)
+        << std::setw(10) << toMicroseconds(latency.getPercentile(50))
+        << std::setw(10) << toMicroseconds(latency.getPercentile(99))
+        << std::setw(10) << toMicroseconds(latency.getPercentile(99.9))
+        << std::setw(10) << toMicroseconds(latency.getMax())
+        << std::setw(10) << dropped << std::setw(8) << report.clientsWithDrops << std::setw(10) << report.clients.corrupted
+        << std::setw(14) << cpuPerFrame;
+    Print::PrintLine(oss.str());
+}
+
+} // namespace GameOfLife::StreamingBench
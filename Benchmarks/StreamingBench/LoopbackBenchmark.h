@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ClientProbe.h"
+#include "IServer.h"
+#include "Log.h"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace GameOfLife::StreamingBench {
+
+// Runs one transport end to end on localhost: a server in this process and a number of
+// clients, either in-process or each in its own forked process.
+class LoopbackBenchmark {
+public:
+    struct Settings {
+        std::string transport;
+        std::string address;
+        int port;
+        int clientCount;
+        bool forkClients;
+        int frameCount;
+        int rate;
+        size_t frameSize;
+        int threadCount;
+        int drainMs;
+        LogLevel logLevel;
+    };
+    struct Report {
+        std::string transport;
+        int clientCount = 0;
+        uint64_t sent = 0;
+        double elapsedSeconds = 0;
+        double serverCpuSeconds = 0;
+        double clientCpuSeconds = 0;
+        ClientProbe::Result clients;
+        int clientsWithDrops = 0;
+    };
+public:
+    explicit LoopbackBenchmark(const Settings& settings);
+    ~LoopbackBenchmark();
+public:
+    std::optional<Report> run();
+public:
+    static void printHeader();
+    static void printReport(const Report& report, size_t frameSize);
+private:
+    struct ForkedClient {
+        pid_t pid = -1;
+        int readFd = -1;
+    };
+private:
+    bool startInProcessClients();
+    bool forkClients();
+    void runForkedClient(int writeFd);
+    bool warmUp(Streaming::IServer& server);
+    void sendMeasuredFrames(Streaming::IServer& server, Report& report);
+    void finish(Streaming::IServer& server, Report& report);
+    bool collectForkedResults(Report& report);
+    void addClientResult(const ClientProbe::Result& result, Report& report) const;
+    int countReadyClients();
+private:
+    using ProbePtr = std::unique_ptr<ClientProbe>;
+    using Probes = std::vector<ProbePtr>;
+    using ForkedClients = std::vector<ForkedClient>;
+private:
+    Settings mSettings;
+    Probes mProbes;
+    ForkedClients mForkedClients;
+    std::vector<bool> mForkedReady;
+};
+
+} // namespace GameOfLife::StreamingBench
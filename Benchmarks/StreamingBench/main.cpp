@@ -0,0 +1,54 @@
+#include "Config.h"
+#include "LoopbackBenchmark.h"
+#include "Log.h"
+
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    using namespace GameOfLife::StreamingBench;
+    try {
+        Config config;
+        if (!config.parseCommandLine(argc, argv)) {
+            return 1;
+        }
+        Log::initConsoleLogger(config.getLogLevel());
+
+        std::vector<LoopbackBenchmark::Report> reports;
+        int port = config.getPort();
+        for (const auto& transport : config.getTransports()) {
+            Print::PrintLine(Print::composeMessage("Measuring", transport.name, "on", transport.address, "..."));
+            LoopbackBenchmark::Settings settings{
+                transport.name,
+                transport.address,
+                port++,
+                config.getClientCount(),
+                config.getForkClients(),
+                config.getFrameCount(),
+                config.getRate(),
+                static_cast<size_t>(config.getFrameSize()),
+                config.getThreadCount(),
+                config.getDrainMs(),
+                config.getLogLevel()
+            };
+            LoopbackBenchmark benchmark(settings);
+            auto report = benchmark.run();
+            if (!report) {
+                Print::PrintLine(Print::composeMessage("Skipping", transport.name, "- the run did not complete"));
+                continue;
+            }
+            reports.push_back(std::move(*report));
+        }
+
+        Print::PrintLine("");
+        LoopbackBenchmark::printHeader();
+        for (const auto& report : reports) {
+            LoopbackBenchmark::printReport(report, static_cast<size_t>(config.getFrameSize()));
+        }
+        Log::destroyLogger();
+        return reports.empty() ? 1 : 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unhandled exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
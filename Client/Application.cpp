@@ -2,10 +2,13 @@
 #include "StreamingFactory.h"
 #include "Print.h"
 #include "Log.h"
+#include "Trace.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 #include "Log.h"
 
@@ -17,7 +20,9 @@ Application::Application()
     , mNewFrameReceived(false)
     , mGridWidth(20)
     , mGridHeight(20)
-    , mCellSize(20) {}
+    , mCellSize(20)
+    , mViewport{ 0, 0, 0, 0 }
+    , mWorldWidth(0) {}
 
 Application::~Application() {
     shutdown();
@@ -39,7 +44,13 @@ bool Application::initialize(int argc, char* argv[]) {
 
     Log::Debug("Logger and Printer initialized.");
 
+    if (!mConfig.getTraceFilename().empty() && !Trace::isCompiledIn()) {
+        Log::Warning("--trace-file is set but tracing is compiled out, rebuild with -DENABLE_TRACING=ON");
+    }
+    TRACE_THREAD_NAME("render");
+
     mCellSize = mConfig.getCellSize();
+    setupTiling();
 
     Print::PrintLine("Game of Life Client initializing...");
     Log::Info("Game of Life Client initializing...");
@@ -84,6 +95,17 @@ void Application::shutdown() {
             mClient->disconnect();
             mClient.reset();
         }
+        mLatencyTracker.logReport();
+
+        const auto& traceFilename = mConfig.getTraceFilename();
+        if (!traceFilename.empty() && Trace::isCompiledIn()) {
+            if (Trace::write(traceFilename)) {
+                Log::Info("Trace written to " + traceFilename);
+            }
+            else {
+                Log::Error("Failed to write trace to " + traceFilename);
+            }
+        }
 
         if (IsWindowReady()) {
             CloseWindow();
@@ -94,7 +116,7 @@ void Application::shutdown() {
 
 bool Application::setupClient() {
     try {
-        mClient = Streaming::StreamingFactory::CreateClient();
+        mClient = Streaming::StreamingFactory::CreateClient(mConfig.getTransport());
         setupCallbacks();
 
         Print::PrintLine(Print::composeMessage("Connecting via multicast group ", mConfig.getMulticastAddress(), " on port ", mConfig.getServerPort()));
@@ -102,6 +124,9 @@ bool Application::setupClient() {
             Print::PrintLine("Failed to join multicast group!", std::cerr);
             return false;
         }
+        if (mTileLayout) {
+            updateTileSubscriptions();
+        }
         return true;
     }
     catch (const std::exception& e) {
@@ -112,6 +137,11 @@ bool Application::setupClient() {
 
 void Application::setupCallbacks() {
     mClient->setOnDataReceived([this](const std::string& data) {
+        mLatencyTracker.onFrameReceived(data);
+        if (mTileLayout) {
+            handleTileFrame(data);
+            return;
+        }
         std::lock_guard<std::mutex> lock(mFrameMutex);
         mLatestFrame = data;
         mNewFrameReceived = true;
@@ -149,6 +179,14 @@ void Application::gameLoop() {
 }
 
 void Application::updateWindowState() {
+    if (mTileLayout) {
+        int dx = (IsKeyPressed(KEY_RIGHT) ? 1 : 0) - (IsKeyPressed(KEY_LEFT) ? 1 : 0);
+        int dy = (IsKeyPressed(KEY_DOWN) ? 1 : 0) - (IsKeyPressed(KEY_UP) ? 1 : 0);
+        if (dx != 0 || dy != 0) {
+            panViewport(dx, dy);
+        }
+    }
+
     bool updateFrame = false;
     std::string currentFrameCopy;
 
@@ -188,6 +226,10 @@ void Application::renderCurrentFrame() {
 
     DrawFPS(10, 10);
     EndDrawing();
+
+    if (!frameToRender.empty()) {
+        mLatencyTracker.onFrameRendered();
+    }
 }
 
 Application::GridSize Application::getGridDimensions(const std::string& frame) {
@@ -211,6 +253,7 @@ Application::GridSize Application::getGridDimensions(const std::string& frame) {
 }
 
 void Application::renderFrame(const std::string& frame) {
+    TRACE_SCOPE("Application::renderFrame");
     const size_t headerLength = 7;
     
     if (mGridWidth <= 0 || mGridHeight <= 0) {
@@ -251,4 +294,100 @@ void Application::renderFrame(const std::string& frame) {
     }
 }
 
+void Application::setupTiling() {
+    auto [worldWidth, worldHeight] = mConfig.getWorldSize();
+    auto [tileWidth, tileHeight] = mConfig.getTileSize();
+    if (worldWidth <= 0 || worldHeight <= 0 || tileWidth <= 0 || tileHeight <= 0) {
+        return;
+    }
+
+    auto [viewportWidth, viewportHeight] = mConfig.getViewportSize();
+    mTileLayout.emplace(worldWidth, worldHeight, tileWidth, tileHeight);
+    mViewport = { 0, 0, std::clamp(viewportWidth, 1, worldWidth), std::clamp(viewportHeight, 1, worldHeight) };
+    mWorldWidth = worldWidth;
+    mWorldCells.assign(static_cast<size_t>(worldWidth) * worldHeight, ' ');
+    mGridWidth = mViewport.width;
+    mGridHeight = mViewport.height;
+    Log::Info(Print::composeMessage("Tiled mode:", mTileLayout->getTileCount(), "tiles, viewport", mViewport.width, "x", mViewport.height));
+}
+
+void Application::handleTileFrame(const std::string& frame) {
+    int tileX = 0;
+    int tileY = 0;
+    if (!Streaming::TileLayout::parseTileHeader(frame, tileX, tileY)) {
+        Log::Debug("Received a frame without tile header in tiled mode, ignoring it.");
+        return;
+    }
+
+    const size_t headerLength = 7;
+    std::string tileFrame = frame.substr(Streaming::TileLayout::TILE_HEADER_LENGTH);
+    auto [tileWidth, tileHeight] = getGridDimensions(tileFrame);
+    if (tileWidth <= 0 || tileHeight <= 0 || tileFrame.length() < headerLength + static_cast<size_t>(tileWidth) * tileHeight) {
+        return;
+    }
+
+    const int worldHeight = static_cast<int>(mWorldCells.size()) / mWorldWidth;
+    if (tileX + tileWidth > mWorldWidth || tileY + tileHeight > worldHeight) {
+        Log::Warning(Print::composeMessage("Tile at", tileX, ",", tileY, "does not fit the configured world size"));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mFrameMutex);
+    for (int row = 0; row < tileHeight; ++row) {
+        auto source = tileFrame.begin() + headerLength + static_cast<size_t>(row) * tileWidth;
+        std::copy(source, source + tileWidth, mWorldCells.begin() + static_cast<size_t>(tileY + row) * mWorldWidth + tileX);
+    }
+    mLatestFrame = composeViewportFrame();
+    mNewFrameReceived = true;
+}
+
+void Application::panViewport(int dx, int dy) {
+    const int worldHeight = static_cast<int>(mWorldCells.size()) / mWorldWidth;
+    {
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mViewport.x = std::clamp(mViewport.x + dx, 0, mWorldWidth - mViewport.width);
+        mViewport.y = std::clamp(mViewport.y + dy, 0, worldHeight - mViewport.height);
+        mLatestFrame = composeViewportFrame();
+        mNewFrameReceived = true;
+    }
+    updateTileSubscriptions();
+}
+
+void Application::updateTileSubscriptions() {
+    auto visibleTiles = mTileLayout->getTilesInRect(mViewport);
+    TileSet requiredTiles(visibleTiles.begin(), visibleTiles.end());
+
+    for (auto it = mSubscribedTiles.begin(); it != mSubscribedTiles.end();) {
+        if (!requiredTiles.contains(*it) && mClient->leaveTile(*it)) {
+            it = mSubscribedTiles.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    for (int tileIndex : requiredTiles) {
+        if (mSubscribedTiles.contains(tileIndex)) {
+            continue;
+        }
+        if (mClient->joinTile(tileIndex)) {
+            mSubscribedTiles.insert(tileIndex);
+        }
+        else {
+            Log::Warning(Print::composeMessage("Failed to subscribe to tile", tileIndex));
+        }
+    }
+}
+
+std::string Application::composeViewportFrame() const {
+    std::ostringstream ss;
+    ss << std::setw(3) << std::setfill('0') << mViewport.width
+       << 'x'
+       << std::setw(3) << std::setfill('0') << mViewport.height;
+    for (int row = mViewport.y; row < mViewport.y + mViewport.height; ++row) {
+        ss.write(mWorldCells.data() + static_cast<size_t>(row) * mWorldWidth + mViewport.x, mViewport.width);
+    }
+    return ss.str();
+}
+
 } // namespace GameOfLife::Client
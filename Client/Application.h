@@ -2,11 +2,15 @@
 
 #include "Config.h"
 #include "IClient.h"
+#include "TileLayout.h"
+#include "LatencyTracker.h"
 #include <raylib.h>
 #include <memory>
 #include <string>
 #include <mutex>
 #include <atomic>
+#include <optional>
+#include <set>
 
 namespace GameOfLife::Client {
 
@@ -26,12 +30,20 @@ private:
     void updateWindowState();
     void renderCurrentFrame();
     void renderFrame(const std::string& frame);
+private:
+    void setupTiling();
+    void handleTileFrame(const std::string& frame);
+    void panViewport(int dx, int dy);
+    void updateTileSubscriptions();
+    std::string composeViewportFrame() const;
 private:
     using GridSize = std::pair<int, int>;
     GridSize getGridDimensions(const std::string& frame);
 private:
     using ClientPtr = std::unique_ptr<Streaming::IClient>;
     using AtomicFlag = std::atomic<bool>;
+    using TileLayoutOptional = std::optional<Streaming::TileLayout>;
+    using TileSet = std::set<int>;
 private:
     Config mConfig;
     ClientPtr mClient;
@@ -43,6 +55,12 @@ private:
     int mGridWidth;
     int mGridHeight;
     int mCellSize;
+    TileLayoutOptional mTileLayout;
+    Streaming::TileLayout::Rect mViewport;
+    int mWorldWidth;
+    std::string mWorldCells;
+    TileSet mSubscribedTiles;
+    LatencyTracker mLatencyTracker;
 };
 
 } // namespace GameOfLife::Client
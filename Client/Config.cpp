@@ -1,9 +1,11 @@
 #include "Config.h"
 #include "Print.h"
 #include "Utils.h"
+#include "StreamingFactory.h"
 
 #include <iostream>
 #include <sstream>
+#include <optional>
 #include <boost/asio/ip/address.hpp>
 
 namespace GameOfLife::Client {
@@ -17,6 +19,20 @@ namespace {
         {"debug", LogLevel::Debug},
         {"trace", LogLevel::Trace}
     };
+
+    std::optional<std::pair<int, int>> parseSize(const std::string& size) {
+        auto separator = size.find('x');
+        if (separator == std::string::npos) {
+            return std::nullopt;
+        }
+        auto isValidDimension = [](int value) { return value >= 0 && value <= 9999; };
+        auto width = stringToInt<int>(size.substr(0, separator), isValidDimension);
+        auto height = stringToInt<int>(size.substr(separator + 1), isValidDimension);
+        if (!width || !height) {
+            return std::nullopt;
+        }
+        return std::make_pair(*width, *height);
+    }
 }    
 
 Config::Config()
@@ -29,7 +45,12 @@ Config::Config()
         ("fps,f", po::value<int>()->default_value(30)->notifier(Config::validateFps), "target frames per second (1-60)")
         ("multicast-address,m", po::value<std::string>()->default_value("239.255.0.1")->notifier(Config::validateMulticastAddress), "multicast group address")
         ("log-level,l", po::value<std::string>()->default_value("info")->notifier(Config::validateLogLevel), "log level (trace, debug, info, warning, error, fatal)")
-        ("log-file", po::value<std::string>()->default_value(""), "path to log file (if empty, logs to console)");
+        ("log-file", po::value<std::string>()->default_value(""), "path to log file (if empty, logs to console)")
+        ("world-size", po::value<std::string>()->default_value("0x0")->notifier(Config::validateSize), "tiled world size in format WxH, must match the server grid (0x0 disables tiling)")
+        ("tile-size", po::value<std::string>()->default_value("0x0")->notifier(Config::validateSize), "server tile size in format WxH")
+        ("viewport", po::value<std::string>()->default_value("40x20")->notifier(Config::validateSize), "visible part of a tiled world in format WxH, pan with arrow keys")
+        ("transport,T", po::value<std::string>()->default_value(Streaming::StreamingFactory::GetDefaultTransport())->notifier(Config::validateTransport), "streaming transport matching the server (asio, beast, poco, poco-websocket, unix, unix-seqpacket, io-uring, shm)")
+        ("trace-file", po::value<std::string>()->default_value(""), "Chrome trace JSON written at shutdown (needs a build with ENABLE_TRACING)");
 }
 
 bool Config::parseCommandLine(int argc, char* argv[]) {
@@ -74,6 +95,10 @@ const std::string& Config::getMulticastAddress() const {
     return mVariablesMap["multicast-address"].as<std::string>();
 }
 
+const std::string& Config::getTransport() const {
+    return mVariablesMap["transport"].as<std::string>();
+}
+
 const std::string& Config::getLogFilename() const {
     return mVariablesMap["log-file"].as<std::string>();
 }
@@ -83,6 +108,22 @@ LogLevel Config::getLogLevel() const {
     return logLevelMap.at(logLevelStr);
 }
 
+std::pair<int, int> Config::getWorldSize() const {
+    return parseSize(mVariablesMap["world-size"].as<std::string>()).value_or(std::make_pair(0, 0));
+}
+
+std::pair<int, int> Config::getTileSize() const {
+    return parseSize(mVariablesMap["tile-size"].as<std::string>()).value_or(std::make_pair(0, 0));
+}
+
+std::pair<int, int> Config::getViewportSize() const {
+    return parseSize(mVariablesMap["viewport"].as<std::string>()).value_or(std::make_pair(0, 0));
+}
+
+const std::string& Config::getTraceFilename() const {
+    return mVariablesMap["trace-file"].as<std::string>();
+}
+
 void Config::validatePort(int port) {
     namespace po = boost::program_options;
     if (!isValidPort(port)) {
@@ -120,15 +161,38 @@ void Config::validateLogLevel(const std::string& level) {
     }
 }
 
+void Config::validateSize(const std::string& size) {
+    namespace po = boost::program_options;
+    if (!parseSize(size)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "size", size);
+    }
+}
+
+void Config::validateTransport(const std::string& transport) {
+    namespace po = boost::program_options;
+    if (!Streaming::StreamingFactory::HasTransport(transport)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "transport", transport);
+    }
+}
+
 void Config::showCurrentConfig() const {
     Print::PrintLine("\nClient Configuration:");
     Print::PrintLine("---------------------");
     Print::PrintLine(Print::composeMessage("Multicast Port:", getServerPort()));
     Print::PrintLine(Print::composeMessage("Multicast Address:", getMulticastAddress()));
+    Print::PrintLine(Print::composeMessage("Transport:", getTransport()));
     Print::PrintLine(Print::composeMessage("Cell Size:", getCellSize()));
     Print::PrintLine(Print::composeMessage("Target FPS:", getTargetFps()));
     Print::PrintLine("Log level: " + mVariablesMap["log-level"].as<std::string>());
     Print::PrintLine(Print::composeMessage("Log File:", getLogFilename().empty() ? "<Console>" : getLogFilename()));
+    auto [worldWidth, worldHeight] = getWorldSize();
+    if (worldWidth > 0 && worldHeight > 0) {
+        auto [tileWidth, tileHeight] = getTileSize();
+        auto [viewportWidth, viewportHeight] = getViewportSize();
+        Print::PrintLine(Print::composeMessage("World Size:", worldWidth, "x", worldHeight));
+        Print::PrintLine(Print::composeMessage("Tile Size:", tileWidth, "x", tileHeight));
+        Print::PrintLine(Print::composeMessage("Viewport:", viewportWidth, "x", viewportHeight));
+    }
     Print::PrintLine("---------------------");
 }
 
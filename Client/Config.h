@@ -17,8 +17,13 @@ public:
     int getCellSize() const;
     int getTargetFps() const;
     const std::string& getMulticastAddress() const;
+    const std::string& getTransport() const;
     const std::string& getLogFilename() const;
     LogLevel getLogLevel() const;
+    std::pair<int, int> getWorldSize() const;
+    std::pair<int, int> getTileSize() const;
+    std::pair<int, int> getViewportSize() const;
+    const std::string& getTraceFilename() const;
 private:
     void showCurrentConfig() const;
 private:
@@ -27,6 +32,8 @@ private:
     static void validateFps(int fps);
     static void validateMulticastAddress(const std::string& address);
     static void validateLogLevel(const std::string& level);
+    static void validateSize(const std::string& size);
+    static void validateTransport(const std::string& transport);
 private:
     using VariablesMap = boost::program_options::variables_map;
     using Description = boost::program_options::options_description;
@@ -0,0 +1,86 @@
+#include "LatencyTracker.h"
+#include "FrameTrailer.h"
+#include "Log.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace GameOfLife::Client {
+
+namespace {
+    const std::chrono::seconds REPORT_INTERVAL(10);
+    const char* STAGE_NAMES[] = { "compute", "encode", "network", "render" };
+}
+
+LatencyTracker::LatencyTracker()
+    : mPendingReceivedNs(0)
+    , mUnstampedFrames(0)
+    , mLastReport(Clock::now()) {
+}
+
+void LatencyTracker::onFrameReceived(const std::string& frame) {
+    const uint64_t receivedNs = Streaming::FrameTrailer::now();
+    size_t trailerPosition = 0;
+    auto stamp = Streaming::FrameTrailer::parse(frame, trailerPosition);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!stamp) {
+        ++mUnstampedFrames;
+        return;
+    }
+    record(Stage::Compute, stamp->tickStartNs, stamp->simulatedNs);
+    record(Stage::Encode, stamp->simulatedNs, stamp->serializedNs);
+    record(Stage::Network, stamp->serializedNs, receivedNs);
+
+    // Frames replaced before they were drawn do not count, render time is measured
+    // from the oldest frame still waiting for the window.
+    if (mPendingReceivedNs == 0) {
+        mPendingReceivedNs = receivedNs;
+    }
+}
+
+void LatencyTracker::onFrameRendered() {
+    const uint64_t renderedNs = Streaming::FrameTrailer::now();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPendingReceivedNs != 0) {
+        record(Stage::Render, mPendingReceivedNs, renderedNs);
+        mPendingReceivedNs = 0;
+    }
+    if (Clock::now() - mLastReport >= REPORT_INTERVAL) {
+        logReportLocked();
+    }
+}
+
+void LatencyTracker::logReport() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    logReportLocked();
+}
+
+void LatencyTracker::record(Stage stage, uint64_t from, uint64_t to) {
+    if (from == 0 || to == 0) {
+        return;
+    }
+    // Clocks of different hosts may disagree slightly, negative durations count as zero.
+    mHistograms[static_cast<size_t>(stage)].record(to > from ? to - from : 0);
+}
+
+void LatencyTracker::logReportLocked() {
+    mLastReport = Clock::now();
+
+    std::ostringstream oss;
+    oss << "Frame latency ms (p50/p99/max):" << std::fixed << std::setprecision(2);
+    for (size_t stage = 0; stage < mHistograms.size(); ++stage) {
+        const auto& histogram = mHistograms[stage];
+        oss << ' ' << STAGE_NAMES[stage] << ' '
+            << histogram.getPercentile(50) / 1e6 << '/'
+            << histogram.getPercentile(99) / 1e6 << '/'
+            << histogram.getMax() / 1e6;
+    }
+    if (mUnstampedFrames > 0) {
+        oss << ", unstamped frames " << mUnstampedFrames;
+    }
+    Log::Info(oss.str());
+}
+
+} // namespace GameOfLife::Client
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Histogram.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace GameOfLife::Client {
+
+// Splits the latency of stamped frames into stages: compute (tick start to simulation
+// done), encode (simulation done to serialized), network (serialized to received, this
+// includes the server send queues) and render (received to drawn). Frames arrive on the
+// transport thread and are drawn on the window thread, so everything is guarded.
+class LatencyTracker {
+public:
+    enum class Stage {
+        Compute,
+        Encode,
+        Network,
+        Render,
+        Count
+    };
+public:
+    LatencyTracker();
+public:
+    void onFrameReceived(const std::string& frame);
+    void onFrameRendered();
+    void logReport();
+private:
+    using Clock = std::chrono::steady_clock;
+    using Histograms = std::array<Histogram, static_cast<size_t>(Stage::Count)>;
+private:
+    void record(Stage stage, uint64_t from, uint64_t to);
+    void logReportLocked();
+private:
+    Histograms mHistograms;
+    uint64_t mPendingReceivedNs;
+    uint64_t mUnstampedFrames;
+    Clock::time_point mLastReport;
+    std::mutex mMutex;
+};
+
+} // namespace GameOfLife::Client
@@ -0,0 +1,196 @@
+#include "BinaryLog.h"
+
+#include <algorithm>
+#include <vector>
+
+BinaryLog::ArgumentWriter::ArgumentWriter(char* data, size_t capacity)
+	: mData(data)
+	, mCapacity(capacity)
+	, mSize(0)
+	, mTruncated(false)
+{}
+
+std::string_view BinaryLog::ArgumentWriter::getData() const {
+	return std::string_view(mData, mSize);
+}
+
+bool BinaryLog::ArgumentWriter::isTruncated() const {
+	return mTruncated;
+}
+
+void BinaryLog::ArgumentWriter::writeTagged(ArgumentType type, const void* value, size_t size) {
+	if (mTruncated || mSize + 1 + size > mCapacity) {
+		mTruncated = true;
+		return;
+	}
+	mData[mSize++] = static_cast<char>(type);
+	std::memcpy(mData + mSize, value, size);
+	mSize += size;
+}
+
+void BinaryLog::ArgumentWriter::writeString(std::string_view value) {
+	const size_t header = 1 + sizeof(uint16_t);
+	if (mTruncated || mSize + header > mCapacity) {
+		mTruncated = true;
+		return;
+	}
+	const size_t length = std::min(value.size(), mCapacity - mSize - header);
+	if (length < value.size()) {
+		mTruncated = true;
+	}
+	const uint16_t storedLength = static_cast<uint16_t>(length);
+	mData[mSize++] = static_cast<char>(ArgumentType::String);
+	std::memcpy(mData + mSize, &storedLength, sizeof(storedLength));
+	mSize += sizeof(storedLength);
+	std::memcpy(mData + mSize, value.data(), length);
+	mSize += length;
+}
+
+BinaryLog::Reader::Reader(std::istream& input)
+	: mInput(input)
+	, mCorrupted(false)
+{}
+
+bool BinaryLog::Reader::readHeader() {
+	char magic[sizeof(MAGIC)];
+	if (!mInput.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+		mCorrupted = true;
+		return false;
+	}
+	return true;
+}
+
+std::optional<BinaryLog::Entry> BinaryLog::Reader::next() {
+	while (!mCorrupted) {
+		char recordType = 0;
+		if (!mInput.get(recordType)) {
+			return std::nullopt;
+		}
+
+		uint32_t siteId = 0;
+		if (recordType == DEFINITION_RECORD) {
+			Site site;
+			if (!read(siteId) || !read(site.line) || !readString(site.fileName) || !readString(site.format)) {
+				break;
+			}
+			mSites[siteId] = std::move(site);
+			continue;
+		}
+		if (recordType != MESSAGE_RECORD) {
+			break;
+		}
+
+		Entry entry;
+		std::string arguments;
+		if (!read(siteId) || !read(entry.logLevel) || !read(entry.timestampNs) || !readString(arguments)) {
+			break;
+		}
+		auto site = mSites.find(siteId);
+		if (site == mSites.end()) {
+			break;
+		}
+		entry.fileName = site->second.fileName;
+		entry.line = site->second.line;
+		entry.message = render(site->second.format, arguments);
+		return entry;
+	}
+
+	// A file cut short by a crash ends in a partial record, everything before it is fine.
+	mCorrupted = true;
+	return std::nullopt;
+}
+
+bool BinaryLog::Reader::isCorrupted() const {
+	return mCorrupted;
+}
+
+template <typename T>
+bool BinaryLog::Reader::read(T& value) {
+	return static_cast<bool>(mInput.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+bool BinaryLog::Reader::readString(std::string& value) {
+	uint16_t length = 0;
+	if (!read(length)) {
+		return false;
+	}
+	value.resize(length);
+	return length == 0 || static_cast<bool>(mInput.read(value.data(), length));
+}
+
+std::string BinaryLog::render(std::string_view format, std::string_view arguments) {
+	std::vector<std::string> values;
+	size_t position = 0;
+	auto readValue = [&arguments, &position](void* value, size_t size) {
+		if (position + size > arguments.size()) {
+			return false;
+		}
+		std::memcpy(value, arguments.data() + position, size);
+		position += size;
+		return true;
+	};
+
+	while (position < arguments.size()) {
+		const auto type = static_cast<ArgumentType>(arguments[position++]);
+		if (type == ArgumentType::Signed) {
+			int64_t number = 0;
+			if (!readValue(&number, sizeof(number))) {
+				break;
+			}
+			values.push_back(std::to_string(number));
+		}
+		else if (type == ArgumentType::Unsigned) {
+			uint64_t number = 0;
+			if (!readValue(&number, sizeof(number))) {
+				break;
+			}
+			values.push_back(std::to_string(number));
+		}
+		else if (type == ArgumentType::Floating) {
+			double number = 0;
+			if (!readValue(&number, sizeof(number))) {
+				break;
+			}
+			std::ostringstream oss;
+			oss << number;
+			values.push_back(oss.str());
+		}
+		else if (type == ArgumentType::Bool) {
+			uint8_t flag = 0;
+			if (!readValue(&flag, sizeof(flag))) {
+				break;
+			}
+			values.push_back(flag ? "1" : "0");
+		}
+		else if (type == ArgumentType::String) {
+			uint16_t length = 0;
+			if (!readValue(&length, sizeof(length)) || position + length > arguments.size()) {
+				break;
+			}
+			values.emplace_back(arguments.substr(position, length));
+			position += length;
+		}
+		else {
+			break;
+		}
+	}
+
+	// Same substitution rules as Print::formatMessage.
+	std::string result;
+	size_t formatPosition = 0;
+	for (const auto& value : values) {
+		const size_t placeholder = format.find("{}", formatPosition);
+		if (placeholder == std::string_view::npos) {
+			result += format.substr(formatPosition);
+			result += ' ';
+			result += value;
+			formatPosition = format.size();
+			continue;
+		}
+		result += format.substr(formatPosition, placeholder - formatPosition);
+		result += value;
+		formatPosition = placeholder + 2;
+	}
+	result += format.substr(formatPosition);
+	return result;
+}
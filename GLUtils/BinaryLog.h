@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+// Compact log file written by Log::initBinaryLogger and rendered later by LogDecoder.
+// After the MAGIC header the file is a sequence of records in host byte order:
+//   definition: 'D' u32 site, u32 line, u16 length + file name, u16 length + format
+//   message:    'M' u32 site, u8 level, i64 timestamp (ns), u16 length + arguments
+// A site is one logging call (file, line and format string) and is defined once,
+// before its first message. Arguments are a tag byte followed by the raw value, so
+// the server never formats anything; plain string messages use the format "{}".
+class BinaryLog {
+public:
+	static constexpr char MAGIC[8] = { 'G', 'O', 'L', 'B', 'L', 'O', 'G', '1' };
+	static constexpr char DEFINITION_RECORD = 'D';
+	static constexpr char MESSAGE_RECORD = 'M';
+	static constexpr const char* PLAIN_FORMAT = "{}";
+
+	enum class ArgumentType : uint8_t {
+		Signed = 1,
+		Unsigned,
+		Floating,
+		Bool,
+		String
+	};
+
+	// Encodes arguments into a caller provided buffer without allocating for numbers and
+	// strings; other types are streamed with operator<< and stored as strings. Arguments
+	// that do not fit are cut and the writer is marked truncated.
+	class ArgumentWriter {
+	public:
+		ArgumentWriter(char* data, size_t capacity);
+	public:
+		template <typename T>
+		void write(const T& value);
+		std::string_view getData() const;
+		bool isTruncated() const;
+	private:
+		void writeTagged(ArgumentType type, const void* value, size_t size);
+		void writeString(std::string_view value);
+	private:
+		char* mData;
+		size_t mCapacity;
+		size_t mSize;
+		bool mTruncated;
+	};
+
+	struct Entry {
+		uint8_t logLevel;
+		int64_t timestampNs;
+		std::string fileName;
+		uint32_t line;
+		std::string message;
+	};
+
+	class Reader {
+	public:
+		explicit Reader(std::istream& input);
+	public:
+		bool readHeader();
+		std::optional<Entry> next();
+		bool isCorrupted() const;
+	private:
+		struct Site {
+			std::string fileName;
+			uint32_t line;
+			std::string format;
+		};
+		using Sites = std::unordered_map<uint32_t, Site>;
+	private:
+		template <typename T>
+		bool read(T& value);
+		bool readString(std::string& value);
+	private:
+		std::istream& mInput;
+		Sites mSites;
+		bool mCorrupted;
+	};
+public:
+	static std::string render(std::string_view format, std::string_view arguments);
+};
+
+template <typename T>
+void BinaryLog::ArgumentWriter::write(const T& value) {
+	using Type = std::decay_t<T>;
+	if constexpr (std::is_same_v<Type, bool>) {
+		const uint8_t flag = value ? 1 : 0;
+		writeTagged(ArgumentType::Bool, &flag, sizeof(flag));
+	}
+	else if constexpr (std::is_same_v<Type, char>) {
+		writeString(std::string_view(&value, 1));
+	}
+	else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+		const int64_t number = value;
+		writeTagged(ArgumentType::Signed, &number, sizeof(number));
+	}
+	else if constexpr (std::is_integral_v<Type>) {
+		const uint64_t number = value;
+		writeTagged(ArgumentType::Unsigned, &number, sizeof(number));
+	}
+	else if constexpr (std::is_floating_point_v<Type>) {
+		const double number = value;
+		writeTagged(ArgumentType::Floating, &number, sizeof(number));
+	}
+	else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+		writeString(std::string_view(value));
+	}
+	else {
+		std::ostringstream oss;
+		oss << value;
+		writeString(oss.str());
+	}
+}
@@ -0,0 +1,135 @@
+#include "Histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const int SUB_BUCKET_BITS = 7;
+    const uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+    const uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    const size_t BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+}
+
+Histogram::Histogram()
+    : mBuckets(BUCKET_COUNT, 0)
+    , mCount(0)
+    , mMin(std::numeric_limits<uint64_t>::max())
+    , mMax(0)
+    , mSum(0)
+{
+}
+
+void Histogram::record(uint64_t value) {
+    ++mBuckets[getBucketIndex(value)];
+    ++mCount;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+    mSum += value;
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        mBuckets[i] += other.mBuckets[i];
+    }
+    mCount += other.mCount;
+    mMin = std::min(mMin, other.mMin);
+    mMax = std::max(mMax, other.mMax);
+    mSum += other.mSum;
+}
+
+void Histogram::reset() {
+    std::fill(mBuckets.begin(), mBuckets.end(), 0);
+    mCount = 0;
+    mMin = std::numeric_limits<uint64_t>::max();
+    mMax = 0;
+    mSum = 0;
+}
+
+uint64_t Histogram::getCount() const {
+    return mCount;
+}
+
+uint64_t Histogram::getMin() const {
+    return mCount > 0 ? mMin : 0;
+}
+
+uint64_t Histogram::getMax() const {
+    return mMax;
+}
+
+double Histogram::getMean() const {
+    return mCount > 0 ? static_cast<double>(mSum / mCount) : 0.0;
+}
+
+uint64_t Histogram::getPercentile(double percentile) const {
+    if (mCount == 0) {
+        return 0;
+    }
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * mCount)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += mBuckets[i];
+        if (seen >= target) {
+            return std::clamp(getBucketUpperBound(i), getMin(), mMax);
+        }
+    }
+    return mMax;
+}
+
+std::string Histogram::serialize() const {
+    // Sparse text form: "count min max sum" followed by "index:count" pairs.
+    std::ostringstream oss;
+    oss << mCount << ' ' << getMin() << ' ' << mMax << ' ' << static_cast<double>(mSum);
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (mBuckets[i] > 0) {
+            oss << ' ' << i << ':' << mBuckets[i];
+        }
+    }
+    return oss.str();
+}
+
+std::optional<Histogram> Histogram::deserialize(const std::string& data) {
+    Histogram histogram;
+    std::istringstream iss(data);
+    double sum = 0;
+    if (!(iss >> histogram.mCount >> histogram.mMin >> histogram.mMax >> sum)) {
+        return std::nullopt;
+    }
+    histogram.mSum = sum;
+    if (histogram.mCount == 0) {
+        histogram.mMin = std::numeric_limits<uint64_t>::max();
+    }
+
+    size_t index = 0;
+    char separator = 0;
+    uint64_t count = 0;
+    while (iss >> index >> separator >> count) {
+        if (separator != ':' || index >= BUCKET_COUNT) {
+            return std::nullopt;
+        }
+        histogram.mBuckets[index] = count;
+    }
+    return histogram;
+}
+
+size_t Histogram::getBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    const int shift = std::bit_width(value) - SUB_BUCKET_BITS;
+    const uint64_t subBucket = value >> shift;
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF));
+}
+
+uint64_t Histogram::getBucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const uint64_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    const uint64_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((subBucket + 1) << shift) - 1;
+}
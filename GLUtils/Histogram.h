@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Log-linear histogram in the spirit of HdrHistogram: every power of two range is split
+// into 64 linear buckets, so any recorded value is reproduced within 1.6% while the whole
+// 64-bit range costs a few kilobytes. Not thread-safe; record per thread and merge.
+class Histogram {
+public:
+    Histogram();
+public:
+    void record(uint64_t value);
+    void merge(const Histogram& other);
+    void reset();
+public:
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double getMean() const;
+    uint64_t getPercentile(double percentile) const;
+public:
+    std::string serialize() const;
+    static std::optional<Histogram> deserialize(const std::string& data);
+private:
+    static size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketUpperBound(size_t index);
+private:
+    using Buckets = std::vector<uint64_t>;
+private:
+    Buckets mBuckets;
+    uint64_t mCount;
+    uint64_t mMin;
+    uint64_t mMax;
+    long double mSum;
+};
@@ -1,32 +1,66 @@
 #include "Log.h"
 
-#include <filesystem>
+#include <algorithm>
+#include <cstring>
 #include <syncstream>
 #include <format>
 
-void Log::initConsoleLogger(LogLevel logLevel) {
+namespace {
+	// How long the writer thread sleeps when the queue is empty and nobody waits on a flush.
+	const std::chrono::milliseconds IDLE_WAIT(10);
+
+	int64_t nowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+}
+
+void Log::initConsoleLogger(LogLevel logLevel, LogOverflowPolicy overflowPolicy) {
 	if (mLogger) {
 		throw std::runtime_error("Logger is already initialized");
 	}
 	mLogger = std::make_unique<LoggerConsole>();
 	mLogLevel = logLevel;
+	mWriter = std::make_unique<AsyncWriter>(*mLogger, overflowPolicy);
 }
 
-void Log::initFileLogger(LogLevel logLevel, const std::string fileName) {
+void Log::initFileLogger(LogLevel logLevel, const std::string fileName, LogOverflowPolicy overflowPolicy) {
 	if (mLogger) {
 		throw std::runtime_error("Logger is already initialized");
 	}
 	mLogger = std::make_unique<LoggerFile>(fileName);
 	mLogLevel = logLevel;
+	mWriter = std::make_unique<AsyncWriter>(*mLogger, overflowPolicy);
+}
+
+void Log::initBinaryLogger(LogLevel logLevel, const std::string fileName, LogOverflowPolicy overflowPolicy) {
+	if (mLogger) {
+		throw std::runtime_error("Logger is already initialized");
+	}
+	mLogger = std::make_unique<LoggerBinary>(fileName);
+	mLogLevel = logLevel;
+	mWriter = std::make_unique<AsyncWriter>(*mLogger, overflowPolicy);
+	mBinaryArguments = true;
 }
 
 void Log::destroyLogger() {
     if (mLogger) {
+        mBinaryArguments = false;
+        mWriter.reset();
         mLogger.reset();
         mLogLevel = LogLevel::Error;
     }
 }
 
+void Log::flush() {
+	if (mWriter) {
+		mWriter->flush();
+	}
+}
+
+uint64_t Log::getDroppedMessages() {
+	return mWriter ? mWriter->getDroppedMessages() : 0;
+}
+
 void Log::Trace(const std::string& message, std::source_location location) {
 	log(LogLevel::Trace, message, location);
 }
@@ -52,41 +86,217 @@ void Log::Throw(const std::string& message, std::source_location location) {
 }
 
 void Log::log(LogLevel messageLogLevel, const std::string& message, std::source_location location) {
-	if (!mLogger) {
+	if (static_cast<int>(messageLogLevel) < GOL_LOG_MIN_LEVEL) {
+		return;
+	}
+	if (!mWriter) {
 		Print::PrintLine(Print::composeMessage("(Logger is not initialized)", message));
+		if (messageLogLevel == LogLevel::Throw) {
+			throw std::runtime_error(message);
+		}
+		return;
 	}
 	if (messageLogLevel >= mLogLevel) {
-		std::ostringstream oss;
-		switch (messageLogLevel) {
-		case LogLevel::Trace:
-			oss << "[TRACE]\t";
-			break;
-		case LogLevel::Debug:
-			oss << "[DEBUG]\t";
-			break;
-		case LogLevel::Info:
-			oss << "[INFO]\t";
-			break;
-		case LogLevel::Warning:
-			oss << "[WARN]\t";
-			break;
-		case LogLevel::Error:
-			oss << "[ERROR]\t";
-			break;
-		case LogLevel::Throw:
-			oss << "[THROW]\t";
+		mWriter->push(messageLogLevel, message, location);
+		if (messageLogLevel == LogLevel::Throw) {
+			mWriter->flush();
+			throw std::runtime_error(formatMessage(messageLogLevel, location.file_name(), location.line(), nowNs(), message));
+		}
+	}
+}
+
+void Log::logArguments(LogLevel messageLogLevel, const Format& format, const BinaryLog::ArgumentWriter& arguments) {
+	if (mWriter) {
+		mWriter->push(messageLogLevel, arguments.getData(), format.location, format.text, arguments.isTruncated());
+	}
+}
+
+std::string Log::formatMessage(LogLevel logLevel, const char* fileName, uint32_t line, int64_t timestampNs, std::string_view message) {
+	// The writer thread formats every message, so only format the timestamp once a second.
+	thread_local int64_t cachedSecond = -1;
+	thread_local std::string cachedTimestamp;
+
+	std::string result;
+	result.reserve(message.size() + 64);
+	switch (logLevel) {
+	case LogLevel::Trace:
+		result += "[TRACE]\t";
+		break;
+	case LogLevel::Debug:
+		result += "[DEBUG]\t";
+		break;
+	case LogLevel::Info:
+		result += "[INFO]\t";
+		break;
+	case LogLevel::Warning:
+		result += "[WARN]\t";
+		break;
+	case LogLevel::Error:
+		result += "[ERROR]\t";
+		break;
+	case LogLevel::Throw:
+		result += "[THROW]\t";
+		break;
+	}
+
+	std::string_view filePath(fileName);
+	const size_t separator = filePath.find_last_of("/\\");
+	result += ' ';
+	result += separator == std::string_view::npos ? filePath : filePath.substr(separator + 1);
+	result += ':';
+	result += std::to_string(line);
+	result += " | ";
+
+	const int64_t second = timestampNs / 1000000000;
+	if (second != cachedSecond) {
+		std::chrono::sys_seconds timestamp{ std::chrono::seconds(second) };
+		cachedTimestamp = std::format("{:%Y-%m-%d %H:%M:%S}", timestamp);
+		cachedSecond = second;
+	}
+	result += cachedTimestamp;
+	result += " | ";
+	result += message;
+	return result;
+}
+
+Log::AsyncWriter::AsyncWriter(Logger& logger, LogOverflowPolicy overflowPolicy)
+	: mLogger(logger)
+	, mOverflowPolicy(overflowPolicy)
+	, mSlots(std::make_unique<Slot[]>(CAPACITY))
+	, mEnqueuePosition(0)
+	, mDequeuePosition(0)
+	, mDroppedMessages(0)
+	, mReportedDroppedMessages(0)
+	, mFlushWaiters(0)
+{
+	for (size_t index = 0; index < CAPACITY; ++index) {
+		mSlots[index].sequence.store(index, std::memory_order_relaxed);
+	}
+	mThread = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+}
+
+Log::AsyncWriter::~AsyncWriter() {
+	mThread.request_stop();
+	if (mThread.joinable()) {
+		mThread.join();
+	}
+}
+
+void Log::AsyncWriter::push(LogLevel logLevel, std::string_view message, const std::source_location& location, const char* format, bool truncated) {
+	const bool mayDrop = mOverflowPolicy == LogOverflowPolicy::Drop && logLevel != LogLevel::Throw;
+	uint64_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+	Slot* slot = nullptr;
+	while (true) {
+		slot = &mSlots[position % CAPACITY];
+		const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+		const int64_t difference = static_cast<int64_t>(sequence - position);
+		if (difference == 0) {
+			if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			// The slot still holds a message from the previous lap: the queue is full.
+			if (mayDrop) {
+				mDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			std::this_thread::yield();
+			position = mEnqueuePosition.load(std::memory_order_relaxed);
+		}
+		else {
+			position = mEnqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	const size_t length = std::min(message.size(), MAX_MESSAGE_LENGTH);
+	slot->logLevel = logLevel;
+	slot->line = location.line();
+	slot->fileName = location.file_name();
+	slot->format = format;
+	slot->timestampNs = nowNs();
+	slot->length = static_cast<uint32_t>(length);
+	slot->truncated = truncated || length < message.size();
+	std::memcpy(slot->text, message.data(), length);
+	slot->sequence.store(position + 1, std::memory_order_release);
+
+	if (position - mDequeuePosition.load(std::memory_order_relaxed) == WAKEUP_BACKLOG) {
+		mCondition.notify_one();
+	}
+}
+
+void Log::AsyncWriter::flush() {
+	const uint64_t target = mEnqueuePosition.load(std::memory_order_acquire);
+	std::unique_lock<std::mutex> lock(mMutex);
+	++mFlushWaiters;
+	mCondition.notify_all();
+	mCondition.wait(lock, [this, target]() {
+		return mDequeuePosition.load(std::memory_order_acquire) >= target;
+	});
+	--mFlushWaiters;
+}
+
+uint64_t Log::AsyncWriter::getDroppedMessages() const {
+	return mDroppedMessages.load(std::memory_order_relaxed);
+}
+
+void Log::AsyncWriter::run(std::stop_token stopToken) {
+	while (true) {
+		const size_t written = writeBatch();
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (written > 0) {
+			mCondition.notify_all();
+			continue;
+		}
+		if (stopToken.stop_requested()) {
 			break;
 		}
-		std::filesystem::path filePath(location.file_name());
-		oss << " " << filePath.filename().string() << ":" << location.line() << " | ";
-		auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
-		oss << std::format("{:%Y-%m-%d %H:%M:%S}", now);
-		oss << " | " << message;
-		mLogger->printMessage(messageLogLevel, oss.str());
-		if (messageLogLevel == LogLevel::Throw) {
-			throw std::runtime_error(oss.str());
+		if (mFlushWaiters > 0) {
+			// A flush is waiting on a message that is claimed but not published yet.
+			lock.unlock();
+			std::this_thread::yield();
+			continue;
+		}
+		// Producers only signal once half the queue is pending, otherwise messages wait for the next wakeup.
+		mCondition.wait_for(lock, stopToken, IDLE_WAIT, [this]() {
+			return mFlushWaiters > 0 || mEnqueuePosition.load(std::memory_order_relaxed) - mDequeuePosition.load(std::memory_order_relaxed) >= WAKEUP_BACKLOG;
+		});
+	}
+}
+
+size_t Log::AsyncWriter::writeBatch() {
+	uint64_t position = mDequeuePosition.load(std::memory_order_relaxed);
+	size_t written = 0;
+	while (written < CAPACITY) {
+		Slot& slot = mSlots[position % CAPACITY];
+		if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+			break;
 		}
+		const Record record{ slot.logLevel, slot.fileName, slot.line, slot.timestampNs, slot.format, std::string_view(slot.text, slot.length), slot.truncated };
+		mLogger.writeRecord(record);
+		slot.sequence.store(position + CAPACITY, std::memory_order_release);
+		++position;
+		++written;
+	}
+
+	const bool reported = reportDropped();
+	if (written > 0 || reported) {
+		mLogger.flush();
 	}
+	mDequeuePosition.store(position, std::memory_order_release);
+	return written;
+}
+
+bool Log::AsyncWriter::reportDropped() {
+	const uint64_t dropped = mDroppedMessages.load(std::memory_order_relaxed);
+	if (dropped == mReportedDroppedMessages) {
+		return false;
+	}
+	const auto location = std::source_location::current();
+	const std::string message = std::to_string(dropped - mReportedDroppedMessages) + " log messages dropped, the log queue was full";
+	mLogger.writeRecord(Record{ LogLevel::Warning, location.file_name(), location.line(), nowNs(), nullptr, message, false });
+	mReportedDroppedMessages = dropped;
+	return true;
 }
 
 Log::LoggerFile::LoggerFile(const std::string& fileName) 
@@ -103,15 +313,91 @@ Log::LoggerFile::~LoggerFile() {
 	}
 }
 
-void Log::LoggerFile::printMessage(LogLevel logLevel, const std::string& message) {
-	Print::PrintLine(message, mFile);
+void Log::LoggerFile::writeRecord(const Record& record) {
+	mFile << formatRecord(record) << '\n';
+}
+
+void Log::LoggerFile::flush() {
+	mFile.flush();
+}
+
+void Log::LoggerConsole::writeRecord(const Record& record) {
+	std::osyncstream out{ record.logLevel <= LogLevel::Warning ? std::cout : std::cerr };
+	out << formatRecord(record) << '\n';
+}
+
+void Log::LoggerConsole::flush() {
+	std::cout.flush();
+}
+
+std::string Log::Logger::formatRecord(const Record& record) {
+	std::string message = record.format
+		? formatMessage(record.logLevel, record.fileName, record.line, record.timestampNs, BinaryLog::render(record.format, record.message))
+		: formatMessage(record.logLevel, record.fileName, record.line, record.timestampNs, record.message);
+	if (record.truncated) {
+		message += "...";
+	}
+	return message;
+}
+
+Log::LoggerBinary::LoggerBinary(const std::string& fileName)
+	: mFile(fileName, std::ios::out | std::ios::trunc | std::ios::binary)
+{
+	if (!mFile.is_open()) {
+		throw std::runtime_error("Failed to open file for logging: " + fileName);
+	}
+	mFile.write(BinaryLog::MAGIC, sizeof(BinaryLog::MAGIC));
 }
 
-void Log::LoggerConsole::printMessage(LogLevel logLevel, const std::string& message) {
-	if (logLevel <= LogLevel::Warning) {
-		Print::PrintLine(message, std::cout);
+void Log::LoggerBinary::writeRecord(const Record& record) {
+	mBuffer.clear();
+	const uint32_t siteId = getSiteId(record);
+
+	// Plain messages are stored as the single string argument of a "{}" site.
+	char plainArguments[MAX_MESSAGE_LENGTH + 3];
+	std::string_view arguments = record.message;
+	if (!record.format) {
+		BinaryLog::ArgumentWriter writer(plainArguments, sizeof(plainArguments));
+		writer.write(record.message);
+		arguments = writer.getData();
 	}
-	else {
-		Print::PrintLine(message, std::cerr);
+
+	mBuffer += BinaryLog::MESSAGE_RECORD;
+	append(siteId);
+	append(static_cast<uint8_t>(record.logLevel));
+	append(record.timestampNs);
+	appendString(arguments);
+	mFile.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+}
+
+void Log::LoggerBinary::flush() {
+	mFile.flush();
+}
+
+uint32_t Log::LoggerBinary::getSiteId(const Record& record) {
+	const SiteKey key{ record.format, record.fileName, record.line };
+	auto site = mSites.find(key);
+	if (site != mSites.end()) {
+		return site->second;
 	}
-}
\ No newline at end of file
+
+	const uint32_t siteId = static_cast<uint32_t>(mSites.size());
+	mSites.emplace(key, siteId);
+	mBuffer += BinaryLog::DEFINITION_RECORD;
+	append(siteId);
+	append(record.line);
+	appendString(record.fileName);
+	appendString(record.format ? record.format : BinaryLog::PLAIN_FORMAT);
+	return siteId;
+}
+
+template <typename T>
+void Log::LoggerBinary::append(const T& value) {
+	mBuffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void Log::LoggerBinary::appendString(std::string_view value) {
+	const uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), UINT16_MAX));
+	append(length);
+	mBuffer.append(value.data(), length);
+}
@@ -1,13 +1,22 @@
 #pragma once
 
 #include "Print.h"
+#include "BinaryLog.h"
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <stdexcept>
 #include <chrono>
 #include <source_location>
 #include <fstream>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+#include <map>
+#include <tuple>
 
 enum class LogLevel {
 	Trace = 0,
@@ -18,6 +27,28 @@ enum class LogLevel {
 	Throw
 };
 
+// Calls below this level are compiled out of the format overloads and skipped by the
+// string ones (0 = trace ... 5 = throw). Release builds keep info and above unless the
+// build sets it, see LOG_MIN_LEVEL in the top-level CMakeLists.txt.
+#ifndef GOL_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define GOL_LOG_MIN_LEVEL 2
+#else
+#define GOL_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// What a producer does when the log queue is full: wait for the writer thread to free
+// a slot, or drop the message and let the writer report how many were lost.
+enum class LogOverflowPolicy {
+	Block,
+	Drop
+};
+
+// Messages are copied into a fixed ring of slots and formatted and written in batches
+// by a background thread, so logging from network threads never waits on the sink.
+// Throw is the exception: it drains the queue before throwing, so the message is out
+// before the stack unwinds.
 class Log {
 public:
 	static void Trace(const std::string& message, std::source_location location = std::source_location::current());
@@ -27,18 +58,71 @@ public:
 	static void Error(const std::string& message, std::source_location location = std::source_location::current());
 	static void Throw(const std::string& message, std::source_location location = std::source_location::current());
 public:
-	static void initConsoleLogger(LogLevel logLevel);
-	static void initFileLogger(LogLevel logLevel, const std::string fileName);
+	// Format string of the overloads below, implicitly built from a literal so the call
+	// site location can still be captured next to the variadic arguments.
+	struct Format {
+		Format(const char* text, std::source_location location = std::source_location::current())
+			: text(text)
+			, location(location)
+		{}
+
+		const char* text;
+		std::source_location location;
+	};
+
+	// Log::Debug("Session {} closed: {}", id, ec.message()) - the arguments are only
+	// formatted when the level is enabled, see Print::formatMessage for the syntax.
+	template <typename... Args>
+	static void Trace(Format format, const Args&... args);
+	template <typename... Args>
+	static void Debug(Format format, const Args&... args);
+	template <typename... Args>
+	static void Info(Format format, const Args&... args);
+	template <typename... Args>
+	static void Warning(Format format, const Args&... args);
+	template <typename... Args>
+	static void Error(Format format, const Args&... args);
+
+	static bool isEnabled(LogLevel logLevel);
+public:
+	static void initConsoleLogger(LogLevel logLevel, LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop);
+	static void initFileLogger(LogLevel logLevel, const std::string fileName, LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop);
+	// Writes BinaryLog records instead of text, render them with the LogDecoder tool.
+	static void initBinaryLogger(LogLevel logLevel, const std::string fileName, LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Drop);
 	static void destroyLogger();
+	static void flush();
+	static uint64_t getDroppedMessages();
+public:
+	static std::string formatMessage(LogLevel logLevel, const char* fileName, uint32_t line, int64_t timestampNs, std::string_view message);
 private:
 	static void log(LogLevel messageLogLevel, const std::string& message, std::source_location location);
+	static void logArguments(LogLevel messageLogLevel, const Format& format, const BinaryLog::ArgumentWriter& arguments);
+	template <typename... Args>
+	static void logFormat(LogLevel messageLogLevel, const Format& format, const Args&... args);
 private:
+	static constexpr size_t MAX_MESSAGE_LENGTH = 480;
+
+	// One queued message as the writer thread hands it to the sink. format is null for
+	// plain text messages, otherwise message holds BinaryLog encoded arguments.
+	struct Record {
+		LogLevel logLevel;
+		const char* fileName;
+		uint32_t line;
+		int64_t timestampNs;
+		const char* format;
+		std::string_view message;
+		bool truncated;
+	};
+
 	class Logger {
 	public:
 		Logger() = default;
 		virtual ~Logger() = default;
 	public:
-		virtual void printMessage(LogLevel logLevel, const std::string& message) = 0;
+		virtual void writeRecord(const Record& record) = 0;
+		virtual void flush() = 0;
+	protected:
+		static std::string formatRecord(const Record& record);
 	};
 
 	class LoggerFile : public Logger
@@ -47,9 +131,30 @@ private:
 		LoggerFile(const std::string& fileName);
 		~LoggerFile();
 	private:
-		void printMessage(LogLevel logLevel, const std::string& message) override;
+		void writeRecord(const Record& record) override;
+		void flush() override;
+	private:
+		std::ofstream mFile;
+	};
+
+	class LoggerBinary : public Logger
+	{
+	public:
+		LoggerBinary(const std::string& fileName);
+	private:
+		void writeRecord(const Record& record) override;
+		void flush() override;
+		uint32_t getSiteId(const Record& record);
+		template <typename T>
+		void append(const T& value);
+		void appendString(std::string_view value);
+	private:
+		using SiteKey = std::tuple<const char*, const char*, uint32_t>;
+		using Sites = std::map<SiteKey, uint32_t>;
 	private:
 		std::ofstream mFile;
+		Sites mSites;
+		std::string mBuffer;
 	};
 
 	class LoggerConsole : public Logger
@@ -57,11 +162,115 @@ private:
 	public:
 		LoggerConsole() = default;
 	private:
-		void printMessage(LogLevel logLevel, const std::string& message) override;
+		void writeRecord(const Record& record) override;
+		void flush() override;
+	};
+
+	// Bounded multi-producer queue (sequence-numbered slots) drained by one writer thread.
+	class AsyncWriter {
+	public:
+		AsyncWriter(Logger& logger, LogOverflowPolicy overflowPolicy);
+		~AsyncWriter();
+		AsyncWriter(const AsyncWriter& other) = delete;
+		AsyncWriter& operator=(const AsyncWriter& other) = delete;
+	public:
+		void push(LogLevel logLevel, std::string_view message, const std::source_location& location, const char* format = nullptr, bool truncated = false);
+		void flush();
+		uint64_t getDroppedMessages() const;
+	private:
+		void run(std::stop_token stopToken);
+		size_t writeBatch();
+		bool reportDropped();
+	private:
+		static constexpr size_t CAPACITY = 4096;
+		static constexpr size_t WAKEUP_BACKLOG = CAPACITY / 2;
+
+		struct Slot {
+			std::atomic<uint64_t> sequence;
+			LogLevel logLevel;
+			uint32_t line;
+			const char* fileName;
+			const char* format;
+			int64_t timestampNs;
+			uint32_t length;
+			bool truncated;
+			char text[MAX_MESSAGE_LENGTH];
+		};
+		using SlotsPtr = std::unique_ptr<Slot[]>;
+	private:
+		Logger& mLogger;
+		LogOverflowPolicy mOverflowPolicy;
+		SlotsPtr mSlots;
+		alignas(64) std::atomic<uint64_t> mEnqueuePosition;
+		alignas(64) std::atomic<uint64_t> mDequeuePosition;
+		std::atomic<uint64_t> mDroppedMessages;
+		uint64_t mReportedDroppedMessages;
+		std::mutex mMutex;
+		std::condition_variable_any mCondition;
+		int mFlushWaiters;
+		std::jthread mThread;
 	};
 private:
 	using LoggerPtr = std::unique_ptr<Logger>;
+	using AsyncWriterPtr = std::unique_ptr<AsyncWriter>;
 private:
 	inline static LoggerPtr mLogger = nullptr;
+	inline static AsyncWriterPtr mWriter = nullptr;
+	inline static bool mBinaryArguments = false;
 	inline static LogLevel mLogLevel = LogLevel::Error;
-};
\ No newline at end of file
+};
+
+inline bool Log::isEnabled(LogLevel logLevel) {
+	return static_cast<int>(logLevel) >= GOL_LOG_MIN_LEVEL && (logLevel >= mLogLevel || !mWriter);
+}
+
+template <typename... Args>
+void Log::logFormat(LogLevel messageLogLevel, const Format& format, const Args&... args) {
+	if (!isEnabled(messageLogLevel)) {
+		return;
+	}
+	if (mBinaryArguments) {
+		char buffer[MAX_MESSAGE_LENGTH];
+		BinaryLog::ArgumentWriter arguments(buffer, sizeof(buffer));
+		(arguments.write(args), ...);
+		logArguments(messageLogLevel, format, arguments);
+	}
+	else {
+		log(messageLogLevel, Print::formatMessage(format.text, args...), format.location);
+	}
+}
+
+template <typename... Args>
+void Log::Trace(Format format, const Args&... args) {
+	if constexpr (GOL_LOG_MIN_LEVEL <= static_cast<int>(LogLevel::Trace)) {
+		logFormat(LogLevel::Trace, format, args...);
+	}
+}
+
+template <typename... Args>
+void Log::Debug(Format format, const Args&... args) {
+	if constexpr (GOL_LOG_MIN_LEVEL <= static_cast<int>(LogLevel::Debug)) {
+		logFormat(LogLevel::Debug, format, args...);
+	}
+}
+
+template <typename... Args>
+void Log::Info(Format format, const Args&... args) {
+	if constexpr (GOL_LOG_MIN_LEVEL <= static_cast<int>(LogLevel::Info)) {
+		logFormat(LogLevel::Info, format, args...);
+	}
+}
+
+template <typename... Args>
+void Log::Warning(Format format, const Args&... args) {
+	if constexpr (GOL_LOG_MIN_LEVEL <= static_cast<int>(LogLevel::Warning)) {
+		logFormat(LogLevel::Warning, format, args...);
+	}
+}
+
+template <typename... Args>
+void Log::Error(Format format, const Args&... args) {
+	if constexpr (GOL_LOG_MIN_LEVEL <= static_cast<int>(LogLevel::Error)) {
+		logFormat(LogLevel::Error, format, args...);
+	}
+}
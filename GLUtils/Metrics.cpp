@@ -0,0 +1,217 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace Metrics {
+
+namespace {
+    std::atomic<size_t> gNextShard(0);
+
+    size_t getShardIndex() {
+        thread_local const size_t shardIndex = gNextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+        return shardIndex;
+    }
+
+    std::string escapeLabelValue(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"': escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    // Renders {a="1",b="2"}, label sets are stored in this form and it doubles as the map key.
+    std::string composeKey(const Labels& labels) {
+        if (labels.empty()) {
+            return "";
+        }
+        Labels sorted = labels;
+        std::sort(sorted.begin(), sorted.end());
+        std::string result = "{";
+        for (const auto& [name, value] : sorted) {
+            result += (result.size() > 1 ? "," : "") + name + "=\"" + escapeLabelValue(value) + "\"";
+        }
+        return result + "}";
+    }
+
+    // Appends one more label to an already rendered label set.
+    std::string extendLabels(const std::string& key, const std::string& name, const std::string& value) {
+        if (key.empty()) {
+            return "{" + name + "=\"" + value + "\"}";
+        }
+        return key.substr(0, key.size() - 1) + "," + name + "=\"" + value + "\"}";
+    }
+
+    // Shortest representation that reads back to the same double.
+    std::string formatValue(double value) {
+        if (std::isinf(value)) {
+            return value > 0 ? "+Inf" : "-Inf";
+        }
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+}
+
+void Counter::increment(uint64_t value) {
+    mShards[getShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Counter::getValue() const {
+    uint64_t total = 0;
+    for (const auto& shard : mShards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Gauge::set(int64_t value) {
+    mValue.store(value, std::memory_order_relaxed);
+}
+
+void Gauge::add(int64_t value) {
+    mValue.fetch_add(value, std::memory_order_relaxed);
+}
+
+int64_t Gauge::getValue() const {
+    return mValue.load(std::memory_order_relaxed);
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : mBounds(std::move(bounds))
+{
+    std::sort(mBounds.begin(), mBounds.end());
+    mBounds.erase(std::unique(mBounds.begin(), mBounds.end()), mBounds.end());
+    for (auto& shard : mShards) {
+        // One extra bucket for values above the largest bound.
+        shard = std::make_unique<Shard>(mBounds.size() + 1);
+    }
+}
+
+void Histogram::observe(double value) {
+    const size_t bucket = std::lower_bound(mBounds.begin(), mBounds.end(), value) - mBounds.begin();
+    auto& shard = *mShards[getShardIndex()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.assign(mBounds.size() + 1, 0);
+    for (const auto& shard : mShards) {
+        for (size_t bucket = 0; bucket < snapshot.buckets.size(); ++bucket) {
+            snapshot.buckets[bucket] += shard->buckets[bucket].load(std::memory_order_relaxed);
+        }
+        snapshot.count += shard->count.load(std::memory_order_relaxed);
+        snapshot.sum += shard->sum.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+const std::vector<double>& Histogram::getBounds() const {
+    return mBounds;
+}
+
+std::vector<double> Histogram::exponentialBounds(double start, double factor, int count) {
+    std::vector<double> bounds;
+    bounds.reserve(count);
+    for (double bound = start; static_cast<int>(bounds.size()) < count; bound *= factor) {
+        bounds.push_back(bound);
+    }
+    return bounds;
+}
+
+Registry& Registry::Get() {
+    static Registry registry;
+    return registry;
+}
+
+Registry::Family& Registry::getFamily(const std::string& name, const std::string& help, Type type) {
+    auto [it, inserted] = mFamilies.try_emplace(name);
+    if (inserted) {
+        it->second.type = type;
+        it->second.help = help;
+    }
+    else if (it->second.type != type) {
+        throw std::invalid_argument("Metric " + name + " is already registered with another type");
+    }
+    return it->second;
+}
+
+Counter& Registry::getCounter(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& metric = getFamily(name, help, Type::Counter).counters[composeKey(labels)];
+    if (!metric) {
+        metric = std::make_unique<Counter>();
+    }
+    return *metric;
+}
+
+Gauge& Registry::getGauge(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& metric = getFamily(name, help, Type::Gauge).gauges[composeKey(labels)];
+    if (!metric) {
+        metric = std::make_unique<Gauge>();
+    }
+    return *metric;
+}
+
+Histogram& Registry::getHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& metric = getFamily(name, help, Type::Histogram).histograms[composeKey(labels)];
+    if (!metric) {
+        metric = std::make_unique<Histogram>(bounds);
+    }
+    return *metric;
+}
+
+std::string Registry::serialize() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::ostringstream oss;
+    for (const auto& [name, family] : mFamilies) {
+        oss << "# HELP " << name << ' ' << family.help << '\n';
+        switch (family.type) {
+        case Type::Counter:
+            oss << "# TYPE " << name << " counter\n";
+            for (const auto& [labels, counter] : family.counters) {
+                oss << name << labels << ' ' << counter->getValue() << '\n';
+            }
+            break;
+        case Type::Gauge:
+            oss << "# TYPE " << name << " gauge\n";
+            for (const auto& [labels, gauge] : family.gauges) {
+                oss << name << labels << ' ' << gauge->getValue() << '\n';
+            }
+            break;
+        case Type::Histogram:
+            oss << "# TYPE " << name << " histogram\n";
+            for (const auto& [labels, histogram] : family.histograms) {
+                const auto snapshot = histogram->getSnapshot();
+                const auto& bounds = histogram->getBounds();
+                uint64_t cumulative = 0;
+                for (size_t bucket = 0; bucket < snapshot.buckets.size(); ++bucket) {
+                    cumulative += snapshot.buckets[bucket];
+                    const double bound = bucket < bounds.size() ? bounds[bucket] : INFINITY;
+                    oss << name << "_bucket" << extendLabels(labels, "le", formatValue(bound)) << ' ' << cumulative << '\n';
+                }
+                oss << name << "_sum" << labels << ' ' << formatValue(snapshot.sum) << '\n';
+                oss << name << "_count" << labels << ' ' << snapshot.count << '\n';
+            }
+            break;
+        }
+    }
+    return oss.str();
+}
+
+} // namespace Metrics
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Process wide metrics in the Prometheus data model. Updates never take a lock:
+// counters and histograms are split into shards on separate cache lines and every
+// thread sticks to one shard, so hot paths on different threads do not contend.
+// Shards are only summed when the registry is serialized.
+namespace Metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+const size_t SHARD_COUNT = 16;
+
+class Counter {
+public:
+    Counter() = default;
+public:
+    void increment(uint64_t value = 1);
+    uint64_t getValue() const;
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{ 0 };
+    };
+    using Shards = std::array<Shard, SHARD_COUNT>;
+private:
+    Shards mShards;
+};
+
+class Gauge {
+public:
+    Gauge() = default;
+public:
+    void set(int64_t value);
+    void add(int64_t value);
+    int64_t getValue() const;
+private:
+    std::atomic<int64_t> mValue{ 0 };
+};
+
+// Fixed upper bounds chosen at registration, matching a Prometheus histogram.
+class Histogram {
+public:
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        double sum = 0;
+    };
+public:
+    explicit Histogram(std::vector<double> bounds);
+public:
+    void observe(double value);
+    Snapshot getSnapshot() const;
+    const std::vector<double>& getBounds() const;
+public:
+    static std::vector<double> exponentialBounds(double start, double factor, int count);
+private:
+    struct alignas(64) Shard {
+        explicit Shard(size_t bucketCount) : buckets(bucketCount) {}
+        std::vector<std::atomic<uint64_t>> buckets;
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<double> sum{ 0 };
+    };
+    using ShardPtr = std::unique_ptr<Shard>;
+    using Shards = std::array<ShardPtr, SHARD_COUNT>;
+private:
+    std::vector<double> mBounds;
+    Shards mShards;
+};
+
+// Metrics are registered once by name and label set and live as long as the process,
+// so callers keep the returned reference instead of looking it up on every update.
+class Registry {
+public:
+    static Registry& Get();
+public:
+    Counter& getCounter(const std::string& name, const std::string& help, const Labels& labels = {});
+    Gauge& getGauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    Histogram& getHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds, const Labels& labels = {});
+    // Text exposition format, version 0.0.4.
+    std::string serialize() const;
+private:
+    Registry() = default;
+private:
+    enum class Type {
+        Counter,
+        Gauge,
+        Histogram
+    };
+    struct Family {
+        Type type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+    using Families = std::map<std::string, Family>;
+private:
+    Family& getFamily(const std::string& name, const std::string& help, Type type);
+private:
+    Families mFamilies;
+    mutable std::mutex mMutex;
+};
+
+} // namespace Metrics
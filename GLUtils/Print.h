@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <sstream>
 #include <memory>
 #include <utility>
 #include <ostream>
@@ -16,6 +18,8 @@ public:
 public:
     template <typename... Args>
     static std::string composeMessage(Args&&... args);
+    template <typename... Args>
+    static std::string formatMessage(std::string_view format, const Args&... args);
 public:
     static void initConsolePrinter();
     static void initFilePrinter(const std::string& fileName);
@@ -62,4 +66,26 @@ std::string Print::composeMessage(Args&&... args) {
         message.pop_back();
     }
     return message;
-}
\ No newline at end of file
+}
+
+// Replaces each "{}" in format with the next argument, streamed with operator<<, so
+// anything composeMessage accepts works here too. Arguments without a placeholder
+// are appended separated by spaces.
+template <typename... Args>
+std::string Print::formatMessage(std::string_view format, const Args&... args) {
+    std::ostringstream oss;
+    size_t position = 0;
+    auto writeArgument = [&oss, &format, &position](const auto& argument) {
+        const size_t placeholder = format.find("{}", position);
+        if (placeholder == std::string_view::npos) {
+            oss << format.substr(position) << ' ' << argument;
+            position = format.size();
+            return;
+        }
+        oss << format.substr(position, placeholder - position) << argument;
+        position = placeholder + 2;
+    };
+    (writeArgument(args), ...);
+    oss << format.substr(position);
+    return oss.str();
+}
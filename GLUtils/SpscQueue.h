@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Bounded queue between exactly one producer thread and one consumer thread. The
+// ring indices are plain atomics, so tryPush/tryPop never lock; push and pop fall
+// back to a condition variable only while the queue is full or empty, and the other
+// side takes the mutex only when someone is actually waiting. close() wakes both
+// sides: push fails from then on, pop keeps returning what is left and then fails.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity);
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+public:
+    bool tryPush(T& value);
+    bool tryPop(T& value);
+    bool push(T value);
+    bool pop(T& value);
+    void close();
+    size_t size() const;
+    size_t capacity() const;
+private:
+    bool isFull() const;
+    bool isEmpty() const;
+    void wake(const std::atomic<bool>& waiting);
+private:
+    using SlotsPtr = std::unique_ptr<T[]>;
+private:
+    SlotsPtr mSlots;
+    size_t mCapacity;
+    alignas(64) std::atomic<uint64_t> mHead;
+    alignas(64) std::atomic<uint64_t> mTail;
+    alignas(64) std::atomic<bool> mProducerWaiting;
+    std::atomic<bool> mConsumerWaiting;
+    std::atomic<bool> mClosed;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+};
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_t capacity)
+    : mSlots(std::make_unique<T[]>(capacity > 0 ? capacity : 1))
+    , mCapacity(capacity > 0 ? capacity : 1)
+    , mHead(0)
+    , mTail(0)
+    , mProducerWaiting(false)
+    , mConsumerWaiting(false)
+    , mClosed(false) {
+}
+
+// Moves from value only on success, so a failed attempt can be retried with it.
+template <typename T>
+bool SpscQueue<T>::tryPush(T& value) {
+    const uint64_t head = mHead.load(std::memory_order_relaxed);
+    if (head - mTail.load(std::memory_order_acquire) >= mCapacity) {
+        return false;
+    }
+    mSlots[head % mCapacity] = std::move(value);
+    mHead.store(head + 1, std::memory_order_seq_cst);
+    wake(mConsumerWaiting);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::tryPop(T& value) {
+    const uint64_t tail = mTail.load(std::memory_order_relaxed);
+    if (mHead.load(std::memory_order_acquire) == tail) {
+        return false;
+    }
+    value = std::move(mSlots[tail % mCapacity]);
+    mTail.store(tail + 1, std::memory_order_seq_cst);
+    wake(mProducerWaiting);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::push(T value) {
+    while (!mClosed.load(std::memory_order_acquire)) {
+        if (tryPush(value)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        mProducerWaiting.store(true);
+        mCondition.wait(lock, [this]() { return mClosed.load() || !isFull(); });
+        mProducerWaiting.store(false);
+    }
+    return false;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T& value) {
+    while (true) {
+        if (tryPop(value)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mClosed.load() && isEmpty()) {
+            return false;
+        }
+        mConsumerWaiting.store(true);
+        mCondition.wait(lock, [this]() { return mClosed.load() || !isEmpty(); });
+        mConsumerWaiting.store(false);
+    }
+}
+
+template <typename T>
+void SpscQueue<T>::close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClosed.store(true);
+    mCondition.notify_all();
+}
+
+template <typename T>
+size_t SpscQueue<T>::size() const {
+    // Tail first: it never passes head, so the difference cannot wrap for a third thread.
+    const uint64_t tail = mTail.load(std::memory_order_acquire);
+    return static_cast<size_t>(mHead.load(std::memory_order_acquire) - tail);
+}
+
+template <typename T>
+size_t SpscQueue<T>::capacity() const {
+    return mCapacity;
+}
+
+template <typename T>
+bool SpscQueue<T>::isFull() const {
+    return mHead.load() - mTail.load() >= mCapacity;
+}
+
+template <typename T>
+bool SpscQueue<T>::isEmpty() const {
+    return mHead.load() == mTail.load();
+}
+
+// The waiting flag is set under the mutex before the waiter checks the indices, and
+// read here after the index was published, so one of the two always sees the other.
+template <typename T>
+void SpscQueue<T>::wake(const std::atomic<bool>& waiting) {
+    if (waiting.load()) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_all();
+    }
+}
@@ -0,0 +1,133 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    const uint64_t RING_CAPACITY = uint64_t(1) << 15;
+
+    // Fields are atomics so a flush running next to the owning thread reads whole
+    // values; events it finds overwritten meanwhile are skipped.
+    struct Event {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> startNs{ 0 };
+        std::atomic<uint64_t> durationNs{ 0 };
+    };
+
+    struct ThreadRing {
+        explicit ThreadRing(uint32_t threadId)
+            : id(threadId)
+            , events(std::make_unique<Event[]>(RING_CAPACITY)) {
+        }
+        const uint32_t id;
+        std::string name;
+        std::unique_ptr<Event[]> events;
+        std::atomic<uint64_t> head{ 0 };
+    };
+
+    using ThreadRingPtr = std::shared_ptr<ThreadRing>;
+
+    // Rings stay registered after their thread exits so its events still get written.
+    std::mutex gRingsMutex;
+    std::vector<ThreadRingPtr> gRings;
+
+    ThreadRing& getThreadRing() {
+        thread_local ThreadRingPtr ring = []() {
+            std::lock_guard<std::mutex> lock(gRingsMutex);
+            auto created = std::make_shared<ThreadRing>(static_cast<uint32_t>(gRings.size() + 1));
+            gRings.push_back(created);
+            return created;
+        }();
+        return *ring;
+    }
+
+    std::string escape(const std::string& value) {
+        std::string escaped;
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+Trace::Scope::Scope(const char* name)
+    : mName(name)
+    , mStartNs(now()) {
+}
+
+Trace::Scope::~Scope() {
+    record(mName, mStartNs, now());
+}
+
+void Trace::setThreadName(const std::string& name) {
+    auto& ring = getThreadRing();
+    std::lock_guard<std::mutex> lock(gRingsMutex);
+    ring.name = name;
+}
+
+void Trace::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    auto& ring = getThreadRing();
+    const uint64_t index = ring.head.load(std::memory_order_relaxed);
+    Event& event = ring.events[index % RING_CAPACITY];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+uint64_t Trace::now() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+bool Trace::write(const std::string& fileName) {
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(gRingsMutex);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&first]() {
+        const char* result = first ? "\n" : ",\n";
+        first = false;
+        return result;
+    };
+
+    file << std::fixed << std::setprecision(3);
+    for (const auto& ring : gRings) {
+        if (!ring->name.empty()) {
+            file << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->id
+                << ",\"args\":{\"name\":\"" << escape(ring->name) << "\"}}";
+        }
+
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+        for (uint64_t index = begin; index < head; ++index) {
+            const Event& event = ring->events[index % RING_CAPACITY];
+            const char* name = event.name.load(std::memory_order_relaxed);
+            const uint64_t startNs = event.startNs.load(std::memory_order_relaxed);
+            const uint64_t durationNs = event.durationNs.load(std::memory_order_relaxed);
+            // The owning thread may have lapped the ring while this one was reading. With the
+            // head at index + RING_CAPACITY it is already overwriting this slot for the next event.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t currentHead = ring->head.load(std::memory_order_relaxed);
+            if (currentHead >= index + RING_CAPACITY) {
+                continue;
+            }
+            file << separator() << "{\"name\":\"" << escape(name ? name : "") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->id
+                << ",\"ts\":" << startNs / 1000.0 << ",\"dur\":" << durationNs / 1000.0 << '}';
+        }
+    }
+    file << "\n]}\n";
+    return file.good();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped tracing of hot paths. TRACE_SCOPE records one complete event (start and
+// duration) into a ring owned by the calling thread, so recording never locks or
+// allocates after the first event of a thread; a full ring overwrites its oldest
+// events. Trace::write dumps all rings as Chrome trace event JSON, which Perfetto and
+// chrome://tracing open. Without ENABLE_TRACING the macros expand to nothing.
+class Trace {
+public:
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+    private:
+        const char* mName;
+        uint64_t mStartNs;
+    };
+public:
+    static void setThreadName(const std::string& name);
+    static bool write(const std::string& fileName);
+    static constexpr bool isCompiledIn() {
+#ifdef ENABLE_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+private:
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+    static uint64_t now();
+};
+
+#ifdef ENABLE_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// The name must outlive the trace, in practice a string literal.
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
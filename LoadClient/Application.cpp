@@ -0,0 +1,237 @@
+#include "Application.h"
+#include "Log.h"
+#include "StreamingFactory.h"
+
+#include <algorithm>
+#include <csignal>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+namespace GameOfLife::LoadClient {
+
+namespace {
+    std::atomic<bool> gShutdownRequested(false);
+
+    const std::chrono::milliseconds LOOP_PERIOD(50);
+    const uint64_t LAG_TOLERANCE = 1;
+
+    double toMilliseconds(uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1e6;
+    }
+}
+
+static void signalHandler(int signal) {
+    Log::Info("Received signal " + std::to_string(signal) + ", initiating shutdown...");
+    gShutdownRequested = true;
+}
+
+Application::Application()
+    : mRunning(false)
+    , mFailedConnects(0)
+    , mWorstSessionId(-1)
+    , mWorstLag(0) {
+}
+
+Application::~Application() {
+    shutdown();
+}
+
+bool Application::initialize(int argc, char* argv[]) {
+    if (!mConfig.parseCommandLine(argc, argv)) {
+        return false;
+    }
+
+    if (!mConfig.getLogFilename().empty()) {
+        Log::initFileLogger(mConfig.getLogLevel(), mConfig.getLogFilename());
+    }
+    else {
+        Log::initConsoleLogger(mConfig.getLogLevel());
+    }
+
+    Log::Info("Game of Life Load Client initializing...");
+    setupSignalHandling();
+    mSessions.reserve(static_cast<size_t>(mConfig.getSessionCount()));
+    mRunning = true;
+    return true;
+}
+
+int Application::run() {
+    if (!mRunning) {
+        Log::Error("Cannot run load client - not properly initialized");
+        return 1;
+    }
+
+    const int sessionCount = mConfig.getSessionCount();
+    const int connectRate = mConfig.getConnectRate();
+    const auto duration = std::chrono::seconds(mConfig.getDuration());
+    const auto reportInterval = std::chrono::seconds(mConfig.getReportInterval());
+
+    printHeader();
+    mStartTime = Clock::now();
+    auto lastReport = mStartTime;
+    std::optional<Clock::time_point> rampFinished;
+
+    while (mRunning && !gShutdownRequested) {
+        const auto now = Clock::now();
+
+        // Open every session that is due according to the connect rate.
+        int dueSessions = sessionCount;
+        if (connectRate > 0) {
+            const double elapsed = std::chrono::duration<double>(now - mStartTime).count();
+            dueSessions = std::min(sessionCount, 1 + static_cast<int>(elapsed * connectRate));
+        }
+        while (static_cast<int>(mSessions.size()) + mFailedConnects < dueSessions && !gShutdownRequested) {
+            openSession();
+        }
+        if (!rampFinished && static_cast<int>(mSessions.size()) + mFailedConnects >= sessionCount) {
+            rampFinished = Clock::now();
+            Log::Info(Print::composeMessage("Ramp up finished,", mSessions.size(), "sessions open,", mFailedConnects, "failed"));
+        }
+
+        if (now - lastReport >= reportInterval) {
+            report(std::chrono::duration<double>(now - lastReport).count());
+            lastReport = now;
+        }
+
+        if (rampFinished && duration.count() > 0 && now - *rampFinished >= duration) {
+            break;
+        }
+        std::this_thread::sleep_for(LOOP_PERIOD);
+    }
+
+    report(std::chrono::duration<double>(Clock::now() - lastReport).count());
+    printSummary();
+    shutdown();
+    return mTotals.corrupted > 0 ? 2 : 0;
+}
+
+void Application::shutdown() {
+    if (mRunning) {
+        Log::Info("Closing load client sessions...");
+        mRunning = false;
+        for (auto& session : mSessions) {
+            session->disconnect();
+        }
+        mSessions.clear();
+        Log::Info("Load client shutdown complete");
+    }
+}
+
+void Application::setupSignalHandling() {
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+}
+
+bool Application::openSession() {
+    const int id = static_cast<int>(mSessions.size()) + mFailedConnects;
+    try {
+        auto session = std::make_unique<Session>(id, Streaming::StreamingFactory::CreateClient(mConfig.getTransport()));
+        if (!session->connect(mConfig.getAddress(), mConfig.getPort())) {
+            Log::Warning(Print::composeMessage("Session", id, "failed to connect"));
+            ++mFailedConnects;
+            return false;
+        }
+        mSessions.push_back(std::move(session));
+        return true;
+    }
+    catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Session", id, "could not be created:", e.what()));
+        ++mFailedConnects;
+        return false;
+    }
+}
+
+void Application::report(double intervalSeconds) {
+    Totals totals;
+    Histogram latency;
+    std::vector<std::pair<int, uint64_t>> lastGenerations;
+    lastGenerations.reserve(mSessions.size());
+    uint64_t newestGeneration = 0;
+    int disconnected = 0;
+
+    for (auto& session : mSessions) {
+        auto stats = session->collect();
+        totals.frames += stats.frames;
+        totals.bytes += stats.bytes;
+        totals.corrupted += stats.corrupted;
+        totals.gaps += stats.gaps;
+        totals.reordered += stats.reordered;
+        totals.unstamped += stats.unstamped;
+        latency.merge(stats.latency);
+        if (!session->isConnected()) {
+            ++disconnected;
+            continue;
+        }
+        lastGenerations.emplace_back(session->getId(), stats.lastGeneration);
+        newestGeneration = std::max(newestGeneration, stats.lastGeneration);
+    }
+
+    // Lag is measured against the newest generation any session has received, so it
+    // does not depend on clocks and shows sessions falling behind their peers.
+    Histogram lag;
+    int lagging = 0;
+    for (const auto& [id, lastGeneration] : lastGenerations) {
+        const uint64_t sessionLag = newestGeneration - lastGeneration;
+        lag.record(sessionLag);
+        if (sessionLag > LAG_TOLERANCE) {
+            ++lagging;
+        }
+        if (sessionLag > mWorstLag) {
+            mWorstLag = sessionLag;
+            mWorstSessionId = id;
+        }
+    }
+
+    const double interval = intervalSeconds > 0 ? intervalSeconds : 1;
+    const double frameRate = static_cast<double>(totals.frames - mTotals.frames) / interval;
+    const double byteRate = static_cast<double>(totals.bytes - mTotals.bytes) / interval / (1024 * 1024);
+    mTotals = totals;
+    mLatency.merge(latency);
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1)
+        << std::setw(8) << std::chrono::duration<double>(Clock::now() - mStartTime).count()
+        << std::setw(7) << mSessions.size() - disconnected << std::setw(6) << disconnected
+        << std::setw(11) << frameRate << std::setw(9) << byteRate
+        << std::setprecision(2)
+        << std::setw(9) << toMilliseconds(latency.getPercentile(50))
+        << std::setw(9) << toMilliseconds(latency.getPercentile(99))
+        << std::setw(9) << toMilliseconds(latency.getPercentile(99.9))
+        << std::setw(8) << lag.getMax() << std::setw(8) << lag.getPercentile(99) << std::setw(8) << lagging
+        << std::setw(8) << totals.gaps << std::setw(8) << totals.reordered << std::setw(8) << totals.corrupted;
+    Print::PrintLine(oss.str());
+}
+
+void Application::printSummary() const {
+    Print::PrintLine("");
+    Print::PrintLine("Load Client Summary:");
+    Print::PrintLine("--------------------");
+    Print::PrintLine(Print::composeMessage("Sessions opened:", mSessions.size(), "failed:", mFailedConnects));
+    Print::PrintLine(Print::composeMessage("Frames received:", mTotals.frames, "bytes:", mTotals.bytes));
+    Print::PrintLine(Print::composeMessage("Corrupted:", mTotals.corrupted, "gaps:", mTotals.gaps, "reordered:", mTotals.reordered, "unstamped:", mTotals.unstamped));
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2)
+        << "Latency ms: p50 " << toMilliseconds(mLatency.getPercentile(50))
+        << " p99 " << toMilliseconds(mLatency.getPercentile(99))
+        << " p99.9 " << toMilliseconds(mLatency.getPercentile(99.9))
+        << " max " << toMilliseconds(mLatency.getMax());
+    Print::PrintLine(oss.str());
+    if (mWorstSessionId >= 0) {
+        Print::PrintLine(Print::composeMessage("Worst lag:", mWorstLag, "generations in session", mWorstSessionId));
+    }
+    Print::PrintLine("--------------------");
+}
+
+void Application::printHeader() {
+    std::ostringstream oss;
+    oss << std::setw(8) << "time s" << std::setw(7) << "open" << std::setw(6) << "lost"
+        << std::setw(11) << "frames/s" << std::setw(9) << "MB/s"
+        << std::setw(9) << "p50 ms" << std::setw(9) << "p99 ms" << std::setw(9) << "p999 ms"
+        << std::setw(8) << "lagmax" << std::setw(8) << "lag99" << std::setw(8) << "behind"
+        << std::setw(8) << "gaps" << std::setw(8) << "reord" << std::setw(8) << "corrupt";
+    Print::PrintLine(oss.str());
+}
+
+} // namespace GameOfLife::LoadClient
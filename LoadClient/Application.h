@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Config.h"
+#include "Session.h"
+#include "Histogram.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GameOfLife::LoadClient {
+
+// Opens many headless sessions against one server at a bounded connect rate and
+// periodically prints the aggregate receive rate, latency and how far the slowest
+// sessions trail the newest generation anyone has seen.
+class Application {
+public:
+    Application();
+    ~Application();
+public:
+    bool initialize(int argc, char* argv[]);
+    int run();
+    void shutdown();
+private:
+    struct Totals {
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t corrupted = 0;
+        uint64_t gaps = 0;
+        uint64_t reordered = 0;
+        uint64_t unstamped = 0;
+    };
+private:
+    void setupSignalHandling();
+    bool openSession();
+    void report(double intervalSeconds);
+    void printSummary() const;
+    static void printHeader();
+private:
+    using Clock = std::chrono::steady_clock;
+    using SessionPtr = std::unique_ptr<Session>;
+    using Sessions = std::vector<SessionPtr>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    Config mConfig;
+    Sessions mSessions;
+    AtomicFlag mRunning;
+    Clock::time_point mStartTime;
+    Totals mTotals;
+    Histogram mLatency;
+    int mFailedConnects;
+    int mWorstSessionId;
+    uint64_t mWorstLag;
+};
+
+} // namespace GameOfLife::LoadClient
@@ -0,0 +1,135 @@
+#include "Config.h"
+#include "StreamingFactory.h"
+#include "Utils.h"
+
+#include <map>
+
+namespace GameOfLife::LoadClient {
+
+namespace {
+    const std::map<std::string, LogLevel> logLevelMap {
+        {"throw", LogLevel::Throw},
+        {"error", LogLevel::Error},
+        {"warning", LogLevel::Warning},
+        {"info", LogLevel::Info},
+        {"debug", LogLevel::Debug},
+        {"trace", LogLevel::Trace}
+    };
+}
+
+Config::Config()
+    : mDescription("Game of Life Load Client Options") {
+    namespace po = boost::program_options;
+    mDescription.add_options()
+        ("help,h", "produce help message")
+        ("log-level,l", po::value<std::string>()->default_value("warning")->notifier(Config::validateLogLevel), "logging level: throw/error/warning/info/debug/trace")
+        ("log-file", po::value<std::string>()->default_value(""), "path to log file (if empty, logs to console)")
+        ("address,a", po::value<std::string>()->default_value("239.255.0.1"), "server or multicast group address, as passed to the regular client")
+        ("port,p", po::value<int>()->default_value(9090)->notifier(Config::validatePort), "server port (0-65535)")
+        ("transport,T", po::value<std::string>()->default_value(Streaming::StreamingFactory::GetDefaultTransport())->notifier(Config::validateTransport), "streaming transport matching the server (asio, beast, poco, poco-websocket, unix, unix-seqpacket, io-uring, shm)")
+        ("sessions,n", po::value<int>()->default_value(100)->notifier([](int value) { validateMinimum("sessions", value, 1); }), "number of concurrent sessions")
+        ("connect-rate,r", po::value<int>()->default_value(100)->notifier([](int value) { validateMinimum("connect-rate", value, 0); }), "sessions opened per second while ramping up, 0 opens all at once")
+        ("duration,d", po::value<int>()->default_value(0)->notifier([](int value) { validateMinimum("duration", value, 0); }), "run time in seconds after the ramp up, 0 runs until interrupted")
+        ("report-interval,i", po::value<int>()->default_value(5)->notifier([](int value) { validateMinimum("report-interval", value, 1); }), "seconds between reports");
+}
+
+bool Config::parseCommandLine(int argc, char* argv[]) {
+    namespace po = boost::program_options;
+
+    try {
+        po::store(po::parse_command_line(argc, argv, mDescription), mVariablesMap);
+        po::notify(mVariablesMap);
+    }
+    catch (const po::error& e) {
+        Print::PrintLine("Failed to parse command line arguments: " + std::string(e.what()));
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    if (mVariablesMap.count("help")) {
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+
+    showCurrentConfig();
+    return true;
+}
+
+LogLevel Config::getLogLevel() const {
+    return logLevelMap.at(mVariablesMap["log-level"].as<std::string>());
+}
+
+const std::string& Config::getLogFilename() const {
+    return mVariablesMap["log-file"].as<std::string>();
+}
+
+const std::string& Config::getAddress() const {
+    return mVariablesMap["address"].as<std::string>();
+}
+
+const std::string& Config::getTransport() const {
+    return mVariablesMap["transport"].as<std::string>();
+}
+
+int Config::getPort() const {
+    return mVariablesMap["port"].as<int>();
+}
+
+int Config::getSessionCount() const {
+    return mVariablesMap["sessions"].as<int>();
+}
+
+int Config::getConnectRate() const {
+    return mVariablesMap["connect-rate"].as<int>();
+}
+
+int Config::getDuration() const {
+    return mVariablesMap["duration"].as<int>();
+}
+
+int Config::getReportInterval() const {
+    return mVariablesMap["report-interval"].as<int>();
+}
+
+void Config::validateLogLevel(const std::string& input) {
+    namespace po = boost::program_options;
+    if (logLevelMap.find(input) == logLevelMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "log-level", input);
+    }
+}
+
+void Config::validateTransport(const std::string& input) {
+    namespace po = boost::program_options;
+    if (!Streaming::StreamingFactory::HasTransport(input)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "transport", input);
+    }
+}
+
+void Config::validatePort(int port) {
+    namespace po = boost::program_options;
+    if (!isValidPort(port)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "port", std::to_string(port));
+    }
+}
+
+void Config::validateMinimum(const std::string& option, int value, int minimum) {
+    namespace po = boost::program_options;
+    if (value < minimum) {
+        throw po::validation_error(po::validation_error::invalid_option_value, option, std::to_string(value));
+    }
+}
+
+void Config::showCurrentConfig() const {
+    Print::PrintLine("\nLoad Client Configuration:");
+    Print::PrintLine("--------------------");
+    Print::PrintLine(Print::composeMessage("Transport:", getTransport()));
+    Print::PrintLine(Print::composeMessage("Address:", getAddress()));
+    Print::PrintLine(Print::composeMessage("Port:", getPort()));
+    Print::PrintLine(Print::composeMessage("Sessions:", getSessionCount()));
+    Print::PrintLine(Print::composeMessage("Connect rate:", (getConnectRate() > 0 ? std::to_string(getConnectRate()) + " sessions/s" : "all at once")));
+    Print::PrintLine(Print::composeMessage("Duration:", (getDuration() > 0 ? std::to_string(getDuration()) + " s" : "until interrupted")));
+    Print::PrintLine(Print::composeMessage("Report interval:", getReportInterval(), "s"));
+    Print::PrintLine("--------------------");
+}
+
+} // namespace GameOfLife::LoadClient
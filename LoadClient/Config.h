@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Log.h"
+#include <boost/program_options.hpp>
+#include <string>
+
+namespace GameOfLife::LoadClient {
+
+class Config
+{
+public:
+    Config();
+public:
+    bool parseCommandLine(int argc, char* argv[]);
+public:
+    LogLevel getLogLevel() const;
+    const std::string& getLogFilename() const;
+    const std::string& getAddress() const;
+    const std::string& getTransport() const;
+    int getPort() const;
+    int getSessionCount() const;
+    int getConnectRate() const;
+    int getDuration() const;
+    int getReportInterval() const;
+private:
+    void showCurrentConfig() const;
+private:
+    static void validateLogLevel(const std::string& input);
+    static void validateTransport(const std::string& input);
+    static void validatePort(int port);
+    static void validateMinimum(const std::string& option, int value, int minimum);
+private:
+    using VariablesMap = boost::program_options::variables_map;
+    using Description = boost::program_options::options_description;
+private:
+    VariablesMap mVariablesMap;
+    Description mDescription;
+};
+
+} // namespace GameOfLife::LoadClient
@@ -0,0 +1,137 @@
+#include "Session.h"
+#include "FrameTrailer.h"
+#include "TileLayout.h"
+
+#include <charconv>
+#include <optional>
+
+namespace GameOfLife::LoadClient {
+
+namespace {
+    const size_t GRID_HEADER_LENGTH = 7;
+    const size_t DIMENSION_DIGITS = 3;
+    const char DIMENSION_SEPARATOR = 'x';
+    const uint64_t WHOLE_GRID_STREAM = 0;
+
+    std::optional<int> parseDimension(const std::string& frame, size_t position) {
+        int value = 0;
+        const char* begin = frame.data() + position;
+        auto result = std::from_chars(begin, begin + DIMENSION_DIGITS, value);
+        if (result.ec != std::errc() || result.ptr != begin + DIMENSION_DIGITS) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    // Checks the optional tile header, the WWWxHHH grid header and that exactly
+    // width * height cells precede cellsEnd. Returns the stream the frame belongs to:
+    // each tile counts generations on its own, whole grid frames share one stream.
+    std::optional<uint64_t> validateLayout(const std::string& frame, size_t cellsEnd) {
+        size_t offset = 0;
+        uint64_t stream = WHOLE_GRID_STREAM;
+        int tileX = 0;
+        int tileY = 0;
+        if (Streaming::TileLayout::parseTileHeader(frame, tileX, tileY)) {
+            offset = Streaming::TileLayout::TILE_HEADER_LENGTH;
+            stream = ((static_cast<uint64_t>(tileX) << 32) | static_cast<uint32_t>(tileY)) + 1;
+        }
+        if (cellsEnd < offset + GRID_HEADER_LENGTH || frame[offset + DIMENSION_DIGITS] != DIMENSION_SEPARATOR) {
+            return std::nullopt;
+        }
+        auto width = parseDimension(frame, offset);
+        auto height = parseDimension(frame, offset + DIMENSION_DIGITS + 1);
+        if (!width || !height || *width <= 0 || *height <= 0) {
+            return std::nullopt;
+        }
+        if (cellsEnd - offset - GRID_HEADER_LENGTH != static_cast<size_t>(*width) * static_cast<size_t>(*height)) {
+            return std::nullopt;
+        }
+        return stream;
+    }
+}
+
+Session::Session(int id, Streaming::ClientPtr client)
+    : mId(id)
+    , mClient(std::move(client))
+    , mDisconnected(false)
+{
+    mClient->setOnDataReceived([this](const std::string& frame) { onFrame(frame); });
+    mClient->setOnDisconnected([this]() { mDisconnected = true; });
+}
+
+Session::~Session() {
+    disconnect();
+}
+
+bool Session::connect(const std::string& address, int port) {
+    return mClient->connect(address, port);
+}
+
+void Session::disconnect() {
+    if (mClient->isConnected()) {
+        mClient->disconnect();
+    }
+}
+
+bool Session::isConnected() const {
+    return !mDisconnected && mClient->isConnected();
+}
+
+int Session::getId() const {
+    return mId;
+}
+
+Session::Stats Session::collect() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats stats = mStats;
+    mStats.latency.reset();
+    return stats;
+}
+
+void Session::onFrame(const std::string& frame) {
+    const uint64_t receivedNs = Streaming::FrameTrailer::now();
+    size_t trailerPosition = 0;
+    auto stamp = Streaming::FrameTrailer::parse(frame, trailerPosition);
+    size_t cellsEnd = trailerPosition;
+    if (!stamp) {
+        cellsEnd = (!frame.empty() && frame.back() == '\n') ? frame.size() - 1 : frame.size();
+    }
+    auto stream = validateLayout(frame, cellsEnd);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mStats.frames;
+    mStats.bytes += frame.size();
+    if (!stream) {
+        ++mStats.corrupted;
+        return;
+    }
+    if (!stamp) {
+        ++mStats.unstamped;
+        return;
+    }
+
+    // Clocks of different hosts may disagree slightly, negative latency counts as zero.
+    if (stamp->serializedNs != 0) {
+        mStats.latency.record(receivedNs > stamp->serializedNs ? receivedNs - stamp->serializedNs : 0);
+    }
+
+    // --generations-per-frame advances the generation by several per frame, the sequence
+    // always by one. Servers without a sequence only ever advanced one generation.
+    const uint64_t sequence = stamp->sequence != 0 ? stamp->sequence : stamp->generation;
+    auto [it, inserted] = mStreamSequences.try_emplace(*stream, sequence);
+    if (!inserted) {
+        uint64_t& lastSequence = it->second;
+        if (sequence <= lastSequence) {
+            ++mStats.reordered;
+        }
+        else {
+            mStats.gaps += sequence - lastSequence - 1;
+            lastSequence = sequence;
+        }
+    }
+    if (stamp->generation > mStats.lastGeneration) {
+        mStats.lastGeneration = stamp->generation;
+    }
+}
+
+} // namespace GameOfLife::LoadClient
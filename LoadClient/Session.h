@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IClient.h"
+#include "Histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace GameOfLife::LoadClient {
+
+// One headless subscriber. Checks every frame it receives (grid header, cell count,
+// frame sequence continuity per stream) and measures latency from the server send stamp.
+class Session {
+public:
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t corrupted = 0;
+        uint64_t gaps = 0;
+        uint64_t reordered = 0;
+        uint64_t unstamped = 0;
+        uint64_t lastGeneration = 0;
+        Histogram latency;
+    };
+public:
+    Session(int id, Streaming::ClientPtr client);
+    ~Session();
+public:
+    bool connect(const std::string& address, int port);
+    void disconnect();
+    bool isConnected() const;
+    int getId() const;
+    // Counters are cumulative, latency covers the frames received since the previous call.
+    Stats collect();
+private:
+    void onFrame(const std::string& frame);
+private:
+    using AtomicFlag = std::atomic<bool>;
+    using StreamSequences = std::unordered_map<uint64_t, uint64_t>;
+private:
+    int mId;
+    Streaming::ClientPtr mClient;
+    Stats mStats;
+    StreamSequences mStreamSequences;
+    mutable std::mutex mMutex;
+    AtomicFlag mDisconnected;
+};
+
+} // namespace GameOfLife::LoadClient
@@ -0,0 +1,17 @@
+#include "Application.h"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    try {
+        GameOfLife::LoadClient::Application app;
+
+        if (!app.initialize(argc, argv)) {
+            return 1;
+        }
+        return app.run();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unhandled exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
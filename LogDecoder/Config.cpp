@@ -0,0 +1,67 @@
+#include "Config.h"
+
+#include <map>
+
+namespace GameOfLife::LogDecoder {
+
+namespace {
+    const std::map<std::string, LogLevel> logLevelMap {
+        {"throw", LogLevel::Throw},
+        {"error", LogLevel::Error},
+        {"warning", LogLevel::Warning},
+        {"info", LogLevel::Info},
+        {"debug", LogLevel::Debug},
+        {"trace", LogLevel::Trace}
+    };
+}
+
+Config::Config()
+    : mDescription("Game of Life Log Decoder Options") {
+    namespace po = boost::program_options;
+    mDescription.add_options()
+        ("help,h", "produce help message")
+        ("input,i", po::value<std::string>()->required(), "binary log written with --log-format binary")
+        ("output,o", po::value<std::string>()->default_value(""), "text log to write (if empty, prints to console)")
+        ("log-level,l", po::value<std::string>()->default_value("trace")->notifier(Config::validateLogLevel), "lowest level to print: throw/error/warning/info/debug/trace");
+    mPositionalDescription.add("input", 1);
+}
+
+bool Config::parseCommandLine(int argc, char* argv[]) {
+    namespace po = boost::program_options;
+
+    try {
+        po::store(po::command_line_parser(argc, argv).options(mDescription).positional(mPositionalDescription).run(), mVariablesMap);
+        if (mVariablesMap.count("help")) {
+            Print::PrintLine(Print::composeMessage(mDescription));
+            return false;
+        }
+        po::notify(mVariablesMap);
+    }
+    catch (const po::error& e) {
+        Print::PrintLine("Failed to parse command line arguments: " + std::string(e.what()));
+        Print::PrintLine(Print::composeMessage(mDescription));
+        return false;
+    }
+    return true;
+}
+
+const std::string& Config::getInputFilename() const {
+    return mVariablesMap["input"].as<std::string>();
+}
+
+const std::string& Config::getOutputFilename() const {
+    return mVariablesMap["output"].as<std::string>();
+}
+
+LogLevel Config::getLogLevel() const {
+    return logLevelMap.at(mVariablesMap["log-level"].as<std::string>());
+}
+
+void Config::validateLogLevel(const std::string& input) {
+    namespace po = boost::program_options;
+    if (logLevelMap.find(input) == logLevelMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "log-level", input);
+    }
+}
+
+} // namespace GameOfLife::LogDecoder
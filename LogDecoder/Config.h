@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Log.h"
+#include <boost/program_options.hpp>
+#include <string>
+
+namespace GameOfLife::LogDecoder {
+
+class Config
+{
+public:
+    Config();
+public:
+    bool parseCommandLine(int argc, char* argv[]);
+public:
+    const std::string& getInputFilename() const;
+    const std::string& getOutputFilename() const;
+    LogLevel getLogLevel() const;
+private:
+    static void validateLogLevel(const std::string& input);
+private:
+    using VariablesMap = boost::program_options::variables_map;
+    using Description = boost::program_options::options_description;
+    using PositionalDescription = boost::program_options::positional_options_description;
+private:
+    VariablesMap mVariablesMap;
+    Description mDescription;
+    PositionalDescription mPositionalDescription;
+};
+
+} // namespace GameOfLife::LogDecoder
@@ -0,0 +1,56 @@
+#include "Config.h"
+#include "BinaryLog.h"
+#include "Log.h"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    try {
+        GameOfLife::LogDecoder::Config config;
+        if (!config.parseCommandLine(argc, argv)) {
+            return 1;
+        }
+
+        std::ifstream input(config.getInputFilename(), std::ios::in | std::ios::binary);
+        if (!input.is_open()) {
+            std::cerr << "Failed to open " << config.getInputFilename() << std::endl;
+            return 1;
+        }
+
+        std::ofstream outputFile;
+        if (!config.getOutputFilename().empty()) {
+            outputFile.open(config.getOutputFilename(), std::ios::out | std::ios::trunc);
+            if (!outputFile.is_open()) {
+                std::cerr << "Failed to open " << config.getOutputFilename() << std::endl;
+                return 1;
+            }
+        }
+        std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+        BinaryLog::Reader reader(input);
+        if (!reader.readHeader()) {
+            std::cerr << config.getInputFilename() << " is not a binary log" << std::endl;
+            return 1;
+        }
+
+        const LogLevel minimumLevel = config.getLogLevel();
+        while (auto entry = reader.next()) {
+            const auto logLevel = static_cast<LogLevel>(entry->logLevel);
+            if (logLevel < minimumLevel) {
+                continue;
+            }
+            output << Log::formatMessage(logLevel, entry->fileName.c_str(), entry->line, entry->timestampNs, entry->message) << '\n';
+        }
+
+        if (reader.isCorrupted()) {
+            std::cerr << "Stopped at a truncated or corrupted record" << std::endl;
+            return 2;
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unhandled exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,15 +1,74 @@
 #include "Application.h"
 #include "Log.h"
 #include "../Streaming/StreamingFactory.h"
+#include "../Streaming/CompositeServer.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "FrameScheduler.h"
+#include "FramePipeline.h"
+#include "LookaheadBuffer.h"
 #include <iostream>
 #include <csignal>
-#include <thread>
+#include <algorithm>
 #include <chrono>
+#include <optional>
+#include <thread>
 
 namespace GameOfLife::Server {
 
 namespace {
+    // Generations queued between two pipeline stages before the earlier one waits.
+    const size_t PIPELINE_DEPTH = 2;
+
     std::atomic<bool> gShutdownRequested(false);
+    std::atomic<bool> gTraceRequested(false);
+
+    struct ServerMetrics {
+        Metrics::Histogram& tickSeconds;
+        Metrics::Histogram& updateSeconds;
+        Metrics::Histogram& serializeSeconds;
+        Metrics::Counter& frames;
+        Metrics::Counter& bytes;
+        Metrics::Gauge& generation;
+        Metrics::Counter& overruns;
+        Metrics::Counter& resyncs;
+        Metrics::Gauge& encodeBacklog;
+        Metrics::Gauge& broadcastBacklog;
+        Metrics::Gauge& lookaheadDepth;
+        Metrics::Gauge& lookaheadOccupancy;
+        Metrics::Counter& lookaheadUnderruns;
+        Metrics::Gauge& rateDivisor;
+        Metrics::Counter& rateChanges;
+    };
+
+    ServerMetrics& getMetrics() {
+        static ServerMetrics metrics = []() {
+            auto& registry = Metrics::Registry::Get();
+            const auto timeBounds = Metrics::Histogram::exponentialBounds(0.0001, 2, 16);
+            return ServerMetrics{
+                registry.getHistogram("gameoflife_tick_seconds", "Simulation tick including serialization and broadcast, without the frame delay", timeBounds),
+                registry.getHistogram("gameoflife_update_seconds", "Time spent computing one generation", timeBounds),
+                registry.getHistogram("gameoflife_serialize_seconds", "Time spent serializing the frames of one generation", timeBounds),
+                registry.getCounter("gameoflife_broadcast_frames_total", "Frames handed to the transports"),
+                registry.getCounter("gameoflife_broadcast_bytes_total", "Bytes handed to the transports"),
+                registry.getGauge("gameoflife_generation", "Current simulation generation"),
+                registry.getCounter("gameoflife_frame_overruns_total", "Ticks that finished after their frame deadline"),
+                registry.getCounter("gameoflife_frame_resyncs_total", "Times the frame schedule fell too far behind and restarted from now"),
+                registry.getGauge("gameoflife_pipeline_encode_backlog", "Generations waiting for the encode stage when --pipeline is on"),
+                registry.getGauge("gameoflife_pipeline_broadcast_backlog", "Encoded generations waiting for the broadcast stage when --pipeline is on"),
+                registry.getGauge("gameoflife_lookahead_depth", "Generations the simulation may run ahead of the broadcast clock (--lookahead)"),
+                registry.getGauge("gameoflife_lookahead_occupancy", "Precomputed generations ready when the last frame was broadcast"),
+                registry.getCounter("gameoflife_lookahead_underruns_total", "Frame deadlines skipped because the look-ahead buffer was empty"),
+                registry.getGauge("gameoflife_frame_rate_divisor", "Current frame rate as a fraction 1/N of --fps, raised under overload"),
+                registry.getCounter("gameoflife_frame_rate_changes_total", "Frame rate changes made by the overload controller")
+            };
+        }();
+        return metrics;
+    }
+
+    double toSeconds(std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
 }
 
 static void signalHandler(int signal) {
@@ -17,8 +76,14 @@ static void signalHandler(int signal) {
     gShutdownRequested = true;
 }
 
+static void traceSignalHandler(int) {
+    gTraceRequested = true;
+}
+
 Application::Application()
-    : mRunning(false) {
+    : mRunning(false)
+    , mGeneration(0)
+    , mFrameSequence(0) {
 }
 
 Application::~Application() {
@@ -30,16 +95,31 @@ bool Application::initialize(int argc, char* argv[]) {
         return false;
     }
 
-    if (!mConfig.getLogFilename().empty()) {
-        Log::initFileLogger(mConfig.getLogLevel(), mConfig.getLogFilename());
+    if (mConfig.getLogFilename().empty()) {
+        Log::initConsoleLogger(mConfig.getLogLevel(), mConfig.getLogOverflowPolicy());
+    }
+    else if (mConfig.isBinaryLog()) {
+        Log::initBinaryLogger(mConfig.getLogLevel(), mConfig.getLogFilename(), mConfig.getLogOverflowPolicy());
     }
     else {
-        Log::initConsoleLogger(mConfig.getLogLevel());
+        Log::initFileLogger(mConfig.getLogLevel(), mConfig.getLogFilename(), mConfig.getLogOverflowPolicy());
     }
 
     Log::Info("Game of Life Server initializing...");
     setupSignalHandling();
 
+    if (!mConfig.getTraceFilename().empty() && !Trace::isCompiledIn()) {
+        Log::Warning("--trace-file is set but tracing is compiled out, rebuild with -DENABLE_TRACING=ON");
+    }
+    TRACE_THREAD_NAME("simulation");
+
+    if (mConfig.getMetricsPort() > 0) {
+        mMetricsEndpoint = std::make_unique<MetricsEndpoint>();
+        if (!mMetricsEndpoint->start(mConfig.getMetricsAddress(), mConfig.getMetricsPort())) {
+            return false;
+        }
+    }
+
     if (!setupServer()) {
         Log::Error("Failed to initialize streaming server");
         return false;
@@ -60,20 +140,146 @@ void Application::run() {
 
     auto [width, height] = mConfig.getGridSize();
     int fps = mConfig.getFps();
-    int frameDelayMs = 1000 / fps;
-    Log::Info("Game of Life grid size: " + std::to_string(width) + "x" + std::to_string(height) + ", " + std::to_string(fps) + " FPS");
+    Log::Info("Game of Life grid size: " + std::to_string(width) + "x" + std::to_string(height) + ", " + (fps > 0 ? std::to_string(fps) + " FPS" : "uncapped FPS"));
 
-    mGameOfLife = std::make_unique<GameOfLife>(width, height);
+    mGameOfLife = std::make_unique<GameOfLife>(width, height, mConfig.getBoundary(), mConfig.getRule());
+    mGameOfLife->setEngine(mConfig.getEngine());
+    mGameOfLife->setThreadCount(mConfig.getThreadCount());
+    if (mConfig.getEngine() == GameOfLife::Engine::Lookup) {
+        Log::Info("Rule {} runs on the lookup table engine", mGameOfLife->getRule().toString());
+    }
+    else if (mConfig.getEngine() == GameOfLife::Engine::Tiled && mConfig.getGenerationsPerFrame() == 1) {
+        Log::Warning("--engine tiled only blocks several generations together, with --generations-per-frame 1 it runs like scalar");
+    }
+    else {
+        Log::Info("Rule {} runs the {} kernel", mGameOfLife->getRule().toString(), (mGameOfLife->hasSpecializedKernel() ? "specialized" : "generic"));
+    }
     mGameOfLife->initializeRandom(mConfig.getFillRatio());
 
+    auto [tileWidth, tileHeight] = mConfig.getTileSize();
+    if (tileWidth > 0 && tileHeight > 0) {
+        if (mServer->supportsTiles()) {
+            mTileLayout.emplace(width, height, tileWidth, tileHeight);
+            Log::Info("Spatial tiling enabled: " + std::to_string(mTileLayout->getColumns()) + "x" + std::to_string(mTileLayout->getRows()) + " tiles");
+        }
+        else if (width > Config::MAX_FRAME_DIMENSION || height > Config::MAX_FRAME_DIMENSION) {
+            Log::Error("Selected transport does not support tiling and the grid is too large to broadcast whole");
+            return;
+        }
+        else {
+            Log::Warning("Selected transport does not support tiling, broadcasting the whole grid");
+        }
+    }
+
+    auto& metrics = getMetrics();
+    std::unique_ptr<LookaheadBuffer> lookahead;
+    std::unique_ptr<FramePipeline> pipeline;
+    if (mConfig.getLookahead() > 0) {
+        if (mConfig.isPipelined()) {
+            Log::Warning("--pipeline is ignored when --lookahead is set");
+        }
+        lookahead = std::make_unique<LookaheadBuffer>(static_cast<size_t>(mConfig.getLookahead()),
+            [this]() { return encodeFrames(*mGameOfLife, simulateGeneration()); });
+        metrics.lookaheadDepth.set(static_cast<int64_t>(lookahead->getDepth()));
+        Log::Info("Look-ahead buffer enabled: {} generations", lookahead->getDepth());
+
+        // Start the clock with a full buffer so the first slow generations are covered too.
+        while (lookahead->getOccupancy() < lookahead->getDepth() && mRunning && !gShutdownRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    else if (mConfig.isPipelined()) {
+        pipeline = std::make_unique<FramePipeline>(PIPELINE_DEPTH,
+            [this](const GameOfLife::Snapshot& snapshot, Streaming::FrameTrailer::Stamp stamp) { return encodeFrames(snapshot, stamp); },
+            [this](const Frames& frames) { broadcastFrames(frames); });
+        Log::Info("Pipelined simulation, serialization and broadcasting enabled");
+    }
+
+    FrameScheduler scheduler(fps);
+    std::optional<RateController> rateController;
+    if (!scheduler.isUncapped() && mConfig.getMaxRateDivisor() > 1) {
+        rateController.emplace(mConfig.getMaxRateDivisor());
+    }
+    metrics.rateDivisor.set(1);
+
+    uint64_t underruns = 0;
+    size_t minimumOccupancy = lookahead ? lookahead->getDepth() : 0;
+    scheduler.start();
     while (mRunning && !gShutdownRequested) {
-        mGameOfLife->update();        
-        std::string asciiFrame = mGameOfLife->toString();
-        mServer->broadcastData(asciiFrame);
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(frameDelayMs));
+        if (gTraceRequested.exchange(false)) {
+            writeTrace();
+        }
+
+        {
+            TRACE_SCOPE("Application::tick");
+            const auto tickStart = std::chrono::steady_clock::now();
+            if (lookahead) {
+                // The producer thread owns the simulation, this loop only keeps the frame clock.
+                Frames frames;
+                if (lookahead->tryTake(frames)) {
+                    broadcastFrames(frames);
+                }
+                else {
+                    ++underruns;
+                    metrics.lookaheadUnderruns.increment();
+                }
+                const size_t occupancy = lookahead->getOccupancy();
+                minimumOccupancy = std::min(minimumOccupancy, occupancy);
+                metrics.lookaheadOccupancy.set(static_cast<int64_t>(occupancy));
+            }
+            else {
+                const auto stamp = simulateGeneration();
+                if (pipeline) {
+                    if (auto snapshot = pipeline->acquireSnapshot()) {
+                        mGameOfLife->takeSnapshot(*snapshot);
+                        pipeline->submit({ std::move(snapshot), stamp });
+                    }
+                    metrics.encodeBacklog.set(static_cast<int64_t>(pipeline->getEncodeBacklog()));
+                    metrics.broadcastBacklog.set(static_cast<int64_t>(pipeline->getBroadcastBacklog()));
+                }
+                else {
+                    broadcastFrames(encodeFrames(*mGameOfLife, stamp));
+                }
+            }
+            auto busy = std::chrono::steady_clock::now() - tickStart;
+            metrics.tickSeconds.observe(toSeconds(busy));
+            if (rateController) {
+                if (lookahead) {
+                    // Broadcasting is cheap here, the producer thread is what falls behind.
+                    busy = std::max<std::chrono::steady_clock::duration>(busy, lookahead->getProduceTime());
+                }
+                adjustFrameRate(*rateController, scheduler, toSeconds(busy) / toSeconds(scheduler.getInterval()));
+            }
+        }
+
+        TRACE_SCOPE("Application::wait");
+        switch (scheduler.waitNextFrame()) {
+        case FrameScheduler::FrameResult::OnTime:
+            break;
+        case FrameScheduler::FrameResult::Overrun:
+            metrics.overruns.increment();
+            break;
+        case FrameScheduler::FrameResult::Resynced:
+            metrics.overruns.increment();
+            metrics.resyncs.increment();
+            Log::Debug("Frame schedule fell behind, resynchronizing");
+            break;
+        }
     }
 
+    if (lookahead) {
+        lookahead->stop();
+        Log::Info("Look-ahead buffer: {} underruns, lowest occupancy {} of {}", underruns, minimumOccupancy, lookahead->getDepth());
+    }
+    if (pipeline) {
+        pipeline->stop();
+    }
+    if (!scheduler.isUncapped()) {
+        Log::Info("Frame schedule: {} overruns, {} resyncs over {} generations", scheduler.getOverruns(), scheduler.getResyncs(), mGeneration);
+        if (rateController && rateController->getDivisor() > 1) {
+            Log::Info("Frame rate was still lowered to 1/{} of {} fps at exit", rateController->getDivisor(), fps);
+        }
+    }
     Log::Info("Server main loop exited");
 }
 
@@ -87,18 +293,131 @@ void Application::shutdown() {
             mServer.reset();
         }
 
+        if (mMetricsEndpoint) {
+            mMetricsEndpoint->stop();
+            mMetricsEndpoint.reset();
+        }
+
+        writeTrace();
+
         Log::Info("Server shutdown complete");
+        Log::flush();
     }
 }
 
 void Application::setupSignalHandling() {
     std::signal(SIGINT, signalHandler);  // Handle Ctrl+C
     std::signal(SIGTERM, signalHandler); // Handle termination request
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, traceSignalHandler); // Dump the trace collected so far
+#endif
+}
+
+void Application::writeTrace() const {
+    const auto& traceFilename = mConfig.getTraceFilename();
+    if (traceFilename.empty() || !Trace::isCompiledIn()) {
+        return;
+    }
+    if (Trace::write(traceFilename)) {
+        Log::Info("Trace written to " + traceFilename);
+    }
+    else {
+        Log::Error("Failed to write trace to " + traceFilename);
+    }
+}
+
+void Application::adjustFrameRate(RateController& rateController, FrameScheduler& scheduler, double load) {
+    const auto decision = rateController.observe(load);
+    if (decision == RateController::Decision::Keep) {
+        return;
+    }
+
+    const int divisor = rateController.getDivisor();
+    scheduler.setDivisor(divisor);
+    auto& metrics = getMetrics();
+    metrics.rateDivisor.set(divisor);
+    metrics.rateChanges.increment();
+
+    const double emittedFps = mConfig.getFps() / static_cast<double>(divisor);
+    if (decision == RateController::Decision::SlowDown) {
+        Log::Warning("Ticks keep exceeding the frame budget (load {}), lowering the frame rate to {} fps", rateController.getLoad(), emittedFps);
+    }
+    else {
+        Log::Info("Frame budget has headroom again (load {}), raising the frame rate to {} fps", rateController.getLoad(), emittedFps);
+    }
+}
+
+Streaming::FrameTrailer::Stamp Application::simulateGeneration() {
+    auto& metrics = getMetrics();
+    const auto updateStart = std::chrono::steady_clock::now();
+    Streaming::FrameTrailer::Stamp stamp;
+    stamp.tickStartNs = Streaming::FrameTrailer::now();
+    const int generations = mConfig.getGenerationsPerFrame();
+    mGameOfLife->advance(generations);
+    mGeneration += static_cast<uint64_t>(generations);
+    stamp.generation = mGeneration;
+    stamp.sequence = ++mFrameSequence;
+    stamp.simulatedNs = Streaming::FrameTrailer::now();
+    metrics.updateSeconds.observe(toSeconds(std::chrono::steady_clock::now() - updateStart));
+    metrics.generation.set(static_cast<int64_t>(mGeneration));
+    return stamp;
+}
+
+template <typename Grid>
+Application::Frames Application::encodeFrames(const Grid& grid, Streaming::FrameTrailer::Stamp stamp) const {
+    auto& metrics = getMetrics();
+    const auto serializeStart = std::chrono::steady_clock::now();
+    Frames frames;
+    if (mTileLayout) {
+        frames.reserve(mTileLayout->getTileCount());
+        for (int tileIndex = 0; tileIndex < mTileLayout->getTileCount(); ++tileIndex) {
+            auto rect = mTileLayout->getTileRect(tileIndex);
+            std::string tileFrame = Streaming::TileLayout::composeTileHeader(rect.x, rect.y);
+            tileFrame += grid.toString(rect.x, rect.y, rect.width, rect.height);
+            stamp.serializedNs = Streaming::FrameTrailer::now();
+            Streaming::FrameTrailer::append(tileFrame, stamp);
+            frames.push_back(std::move(tileFrame));
+        }
+    }
+    else {
+        std::string asciiFrame = grid.toString();
+        stamp.serializedNs = Streaming::FrameTrailer::now();
+        Streaming::FrameTrailer::append(asciiFrame, stamp);
+        frames.push_back(std::move(asciiFrame));
+    }
+    metrics.serializeSeconds.observe(toSeconds(std::chrono::steady_clock::now() - serializeStart));
+    return frames;
+}
+
+void Application::broadcastFrames(const Frames& frames) {
+    auto& metrics = getMetrics();
+    for (size_t index = 0; index < frames.size(); ++index) {
+        if (mTileLayout) {
+            TRACE_SCOPE("IServer::broadcastTile");
+            mServer->broadcastTile(static_cast<int>(index), frames[index]);
+        }
+        else {
+            TRACE_SCOPE("IServer::broadcastData");
+            mServer->broadcastData(frames[index]);
+        }
+        metrics.frames.increment();
+        metrics.bytes.increment(frames[index].size());
+    }
 }
 
 bool Application::setupServer() {    
     try {
-        mServer = Streaming::StreamingFactory::CreateServer();
+        auto transports = mConfig.getTransports();
+        if (transports.size() == 1 && transports.front().address.empty() && transports.front().port == 0) {
+            mServer = Streaming::StreamingFactory::CreateServer(transports.front().name);
+        }
+        else {
+            auto compositeServer = std::make_shared<Streaming::CompositeServer>();
+            for (const auto& transport : transports) {
+                compositeServer->addServer(Streaming::StreamingFactory::CreateServer(transport.name), transport.address, transport.port);
+            }
+            mServer = std::move(compositeServer);
+        }
         
         Log::Info("Starting server on port " + std::to_string(mConfig.getPort()) + " with multicast " + mConfig.getMulticastAddress());
         
@@ -3,8 +3,17 @@
 #include "Config.h"
 #include "IServer.h"
 #include "GameOfLife.h"
+#include "TileLayout.h"
+#include "FrameTrailer.h"
+#include "MetricsEndpoint.h"
+#include "FrameScheduler.h"
+#include "RateController.h"
 #include <memory>
 #include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace GameOfLife::Server {
 
@@ -18,16 +27,29 @@ public:
     void shutdown();
 private:
     void setupSignalHandling();
+    void writeTrace() const;
     bool setupServer();
+    Streaming::FrameTrailer::Stamp simulateGeneration();
+    void adjustFrameRate(RateController& rateController, FrameScheduler& scheduler, double load);
+    // Grid is the live GameOfLife or a GameOfLife::Snapshot of it.
+    template <typename Grid>
+    std::vector<std::string> encodeFrames(const Grid& grid, Streaming::FrameTrailer::Stamp stamp) const;
+    void broadcastFrames(const std::vector<std::string>& frames);
 private:
+    using Frames = std::vector<std::string>;
     using AtomicFlag = std::atomic<bool>;
     using ServerPtr = std::shared_ptr<Streaming::IServer>;
     using GameOfLifePtr = std::unique_ptr<GameOfLife>;
+    using MetricsEndpointPtr = std::unique_ptr<MetricsEndpoint>;
 private:
     Config mConfig;
     ServerPtr mServer;
     AtomicFlag mRunning;
     GameOfLifePtr mGameOfLife;
+    uint64_t mGeneration;
+    uint64_t mFrameSequence;
+    MetricsEndpointPtr mMetricsEndpoint;
+    std::optional<Streaming::TileLayout> mTileLayout;
 };
 
 } // namespace GameOfLife::Server
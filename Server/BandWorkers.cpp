@@ -0,0 +1,83 @@
+#include "BandWorkers.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <string>
+
+namespace GameOfLife::Server {
+
+BandWorkers::BandWorkers(int threadCount)
+    : mJob(nullptr)
+    , mWorkerCount(0)
+    , mPending(0)
+    , mRound(0)
+{
+    mThreads.reserve(std::max(threadCount - 1, 0));
+    for (int worker = 1; worker < threadCount; ++worker) {
+        mThreads.emplace_back([this, worker](std::stop_token stopToken) { runWorker(stopToken, worker); });
+    }
+}
+
+BandWorkers::~BandWorkers() {
+    // Stop all of them first, joining one by one would wait for each wake-up in turn.
+    for (auto& thread : mThreads) {
+        thread.request_stop();
+    }
+    mThreads.clear();
+}
+
+int BandWorkers::getThreadCount() const {
+    return static_cast<int>(mThreads.size()) + 1;
+}
+
+void BandWorkers::run(int workerCount, const Job& job) {
+    workerCount = std::clamp(workerCount, 1, getThreadCount());
+    if (workerCount == 1) {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &job;
+        mWorkerCount = workerCount;
+        mPending = workerCount - 1;
+        ++mRound;
+    }
+    mWake.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() { return mPending == 0; });
+    mJob = nullptr;
+}
+
+void BandWorkers::runWorker(std::stop_token stopToken, int worker) {
+    TRACE_THREAD_NAME("band " + std::to_string(worker));
+    uint64_t round = 0;
+    while (true) {
+        const Job* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (!mWake.wait(lock, stopToken, [this, round]() { return mRound != round; })) {
+                return;
+            }
+            round = mRound;
+            // Workers beyond the requested count sit this round out.
+            if (worker >= mWorkerCount) {
+                continue;
+            }
+            job = mJob;
+        }
+
+        (*job)(worker);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mPending == 0) {
+            mDone.notify_one();
+        }
+    }
+}
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace GameOfLife::Server {
+
+// Threads that stay parked between generations and each run their share of a job on
+// request, so a generation costs one wake-up per worker instead of a thread start and
+// join. The calling thread always takes worker 0 and run() returns once every worker
+// it asked for has finished.
+class BandWorkers {
+public:
+    using Job = std::function<void(int worker)>;
+public:
+    explicit BandWorkers(int threadCount);
+    ~BandWorkers();
+    BandWorkers(const BandWorkers& other) = delete;
+    BandWorkers& operator=(const BandWorkers& other) = delete;
+public:
+    int getThreadCount() const;
+    // Runs job(worker) for every worker below workerCount, capped to the thread count.
+    void run(int workerCount, const Job& job);
+private:
+    void runWorker(std::stop_token stopToken, int worker);
+private:
+    std::mutex mMutex;
+    std::condition_variable_any mWake;
+    std::condition_variable mDone;
+    const Job* mJob;
+    int mWorkerCount;
+    int mPending;
+    uint64_t mRound;
+    std::vector<std::jthread> mThreads;
+};
+
+} // namespace GameOfLife::Server
@@ -1,9 +1,13 @@
 #include "Config.h"
 #include "Log.h"
+#include "StreamingFactory.h"
+#include "TileLayout.h"
+#include "Utils.h"
 
 #include <iostream>
 #include <sstream>
 #include <regex>
+#include <optional>
 #include <boost/program_options.hpp>
 #include <boost/asio/ip/address.hpp>
 
@@ -18,6 +22,49 @@ namespace {
         {"debug", LogLevel::Debug},
         {"trace", LogLevel::Trace}
     };
+
+    const std::map<std::string, LogOverflowPolicy> logOverflowMap {
+        {"block", LogOverflowPolicy::Block},
+        {"drop", LogOverflowPolicy::Drop}
+    };
+
+    const std::map<std::string, GameOfLife::Boundary> boundaryMap {
+        {"torus", GameOfLife::Boundary::Torus},
+        {"dead", GameOfLife::Boundary::Dead}
+    };
+
+    const std::map<std::string, GameOfLife::Engine> engineMap {
+        {"scalar", GameOfLife::Engine::Scalar},
+        {"lut", GameOfLife::Engine::Lookup},
+        {"tiled", GameOfLife::Engine::Tiled}
+    };
+
+    // Transport list format: name[@address][:port],name[@address][:port],...
+    std::optional<std::vector<TransportSpec>> parseTransports(const std::string& input) {
+        std::vector<TransportSpec> transports;
+        std::regex transportRegex("([a-z-]+)(?:@([^:]+))?(?::(\\d+))?");
+        std::istringstream iss(input);
+        std::string item;
+        while (std::getline(iss, item, ',')) {
+            std::smatch matches;
+            if (!std::regex_match(item, matches, transportRegex)) {
+                return std::nullopt;
+            }
+            transports.push_back({ matches[1], matches[2], matches[3].matched ? std::stoi(matches[3]) : 0 });
+        }
+        if (transports.empty()) {
+            return std::nullopt;
+        }
+        return transports;
+    }
+
+    std::string composeTransportsHelp() {
+        std::string help = "comma separated transports as name[@address][:port], available:";
+        for (const auto& transport : Streaming::StreamingFactory::GetTransports()) {
+            help += " " + transport;
+        }
+        return help;
+    }
 }
 
 Config::Config()
@@ -28,11 +75,25 @@ Config::Config()
         ("port,p", po::value<int>()->default_value(9000), "server's port")
         ("log-level,l", po::value<std::string>()->default_value("info")->notifier(Config::validateLogLevel), "logging level: throw/error/warning/info/debug/trace")
         ("log-file,L", po::value<std::string>()->default_value(""), "logging file")        
-        ("fps,f", po::value<int>()->default_value(1)->notifier(Config::validateFps), "frames per second (1-30)")
-        ("grid-size,g", po::value<std::string>()->default_value("40x20")->notifier(Config::validateGridSize), "grid size in format WxH (e.g., 40x20)")
+        ("log-overflow", po::value<std::string>()->default_value("drop")->notifier(Config::validateLogOverflow), "what logging threads do when the log queue is full: drop/block")
+        ("log-format", po::value<std::string>()->default_value("text")->notifier(Config::validateLogFormat), "format of the log file: text, or binary to be rendered later with LogDecoder")
+        ("fps,f", po::value<int>()->default_value(1)->notifier(Config::validateFps), "frames per second (1-1000, 0 runs uncapped for benchmarking)")
+        ("grid-size,g", po::value<std::string>()->default_value("40x20")->notifier(Config::validateGridSize), "grid size in format WxH (e.g., 40x20), 10-200 per side, up to 9999 with --tile-size")
+        ("tile-size", po::value<std::string>()->default_value("0x0")->notifier(Config::validateTileSize), "multicast tile size in format WxH up to 200x200, each tile is sent to its own group after the base group, at most 4096 tiles (0x0 disables tiling)")
         ("fill-ratio,r", po::value<float>()->default_value(0.3f)->notifier(Config::validateFillRatio), "percentage of initially alive cells (0.0-1.0)")
-        ("threads,t", po::value<int>()->default_value(2)->notifier(Config::validateThreadCount), "number of threads in the thread pool (1-64)")
-        ("multicast-address,m", po::value<std::string>()->default_value("239.255.0.1")->notifier(Config::validateMulticastAddress), "multicast group address");
+        ("boundary", po::value<std::string>()->default_value("torus")->notifier(Config::validateBoundary), "grid edges: torus wraps around to the opposite edge, dead treats cells beyond the edge as dead")
+        ("rule", po::value<std::string>()->default_value("B3/S23")->notifier(Config::validateRule), "life-like rule in B/S notation, e.g. B3/S23 (Conway), B36/S23 (HighLife), B3678/S34678 (Day & Night), B2/S (Seeds)")
+        ("engine", po::value<std::string>()->default_value("scalar")->notifier(Config::validateEngine), "simulation engine: scalar (per cell, vectorized where the compiler can), lut (2x2 blocks through a 64K lookup table, for targets without wide SIMD), tiled (scalar, several generations per cache-sized band when --generations-per-frame is above 1)")
+        ("generations-per-frame", po::value<int>()->default_value(1)->notifier(Config::validateGenerationsPerFrame), "generations simulated per broadcast frame, to fast-forward (1-64)")
+        ("threads,t", po::value<int>()->default_value(2)->notifier(Config::validateThreadCount), "number of threads simulating the grid, each one updates its own band of rows (1-64)")
+        ("multicast-address,m", po::value<std::string>()->default_value("239.255.0.1")->notifier(Config::validateMulticastAddress), "multicast group address")
+        ("transport,T", po::value<std::string>()->default_value(Streaming::StreamingFactory::GetDefaultTransport())->notifier(Config::validateTransports), composeTransportsHelp().c_str())
+        ("metrics-port", po::value<int>()->default_value(0)->notifier(Config::validateMetricsPort), "port of the Prometheus metrics HTTP endpoint (0 disables it)")
+        ("metrics-address", po::value<std::string>()->default_value("0.0.0.0")->notifier(Config::validateMetricsAddress), "address the metrics endpoint listens on")
+        ("pipeline", po::bool_switch()->default_value(false), "simulate, serialize and broadcast on separate pipelined threads")
+        ("lookahead", po::value<int>()->default_value(0)->notifier(Config::validateLookahead), "generations simulated ahead of the broadcast clock to absorb slow ticks (0-256, 0 disables it)")
+        ("max-rate-divisor", po::value<int>()->default_value(8)->notifier(Config::validateMaxRateDivisor), "lowest frame rate the server falls back to under overload, as a fraction 1/N of --fps (1-64, 1 keeps the rate fixed)")
+        ("trace-file", po::value<std::string>()->default_value(""), "Chrome trace JSON written at shutdown and on SIGUSR1 (needs a build with ENABLE_TRACING)");
 }
 
 bool Config::parseCommandLine(int argc, char* argv[]) {
@@ -53,6 +114,24 @@ bool Config::parseCommandLine(int argc, char* argv[]) {
         return false;
     }
 
+    auto [width, height] = getGridSize();
+    auto [tileWidth, tileHeight] = getTileSize();
+    if (tileWidth == 0 && (width > MAX_FRAME_DIMENSION || height > MAX_FRAME_DIMENSION)) {
+        Print::PrintLine(Print::composeMessage("Grid sizes above", MAX_FRAME_DIMENSION, "x", MAX_FRAME_DIMENSION, "need --tile-size"));
+        return false;
+    }
+    if (tileWidth > 0) {
+        const int tileCount = Streaming::TileLayout(width, height, tileWidth, tileHeight).getTileCount();
+        if (tileCount > MAX_TILE_COUNT) {
+            Print::PrintLine(Print::composeMessage("--tile-size", tileWidth, "x", tileHeight, "splits the grid into", tileCount, "tiles, at most", MAX_TILE_COUNT, "are allowed"));
+            return false;
+        }
+        if (Streaming::TileLayout::getGroupAddress(getMulticastAddress(), tileCount - 1).empty()) {
+            Print::PrintLine(Print::composeMessage("The", tileCount, "tile groups after", getMulticastAddress(), "do not fit in the IPv4 multicast range 224.0.0.0/4"));
+            return false;
+        }
+    }
+
     showCurrentConfig();
     return true;
 }
@@ -61,6 +140,14 @@ const std::string& Config::getLogFilename() const {
     return mVariablesMap["log-file"].as<std::string>();
 }
 
+bool Config::isBinaryLog() const {
+    return mVariablesMap["log-format"].as<std::string>() == "binary";
+}
+
+LogOverflowPolicy Config::getLogOverflowPolicy() const {
+    return logOverflowMap.at(mVariablesMap["log-overflow"].as<std::string>());
+}
+
 LogLevel Config::getLogLevel() const {
     const std::string logLevelStr = mVariablesMap["log-level"].as<std::string>();
     return logLevelMap.at(logLevelStr);
@@ -88,18 +175,88 @@ std::pair<int, int> Config::getGridSize() const {
     return {40, 20};
 }
 
+std::pair<int, int> Config::getTileSize() const {
+    std::string tileSizeStr = mVariablesMap["tile-size"].as<std::string>();
+    std::regex tileSizeRegex("(\\d+)x(\\d+)");
+    std::smatch matches;
+    
+    if (std::regex_match(tileSizeStr, matches, tileSizeRegex)) {
+        return {std::stoi(matches[1]), std::stoi(matches[2])};
+    }
+    
+    return {0, 0};
+}
+
 float Config::getFillRatio() const {
     return mVariablesMap["fill-ratio"].as<float>();
 }
 
+GameOfLife::Boundary Config::getBoundary() const {
+    return boundaryMap.at(mVariablesMap["boundary"].as<std::string>());
+}
+
+Rule Config::getRule() const {
+    return Rule::parse(mVariablesMap["rule"].as<std::string>()).value_or(CONWAY_RULE);
+}
+
+GameOfLife::Engine Config::getEngine() const {
+    return engineMap.at(mVariablesMap["engine"].as<std::string>());
+}
+
+int Config::getGenerationsPerFrame() const {
+    return mVariablesMap["generations-per-frame"].as<int>();
+}
+
 int Config::getThreadCount() const {
     return mVariablesMap["threads"].as<int>();
 }
 
+int Config::getMetricsPort() const {
+    return mVariablesMap["metrics-port"].as<int>();
+}
+
+const std::string& Config::getMetricsAddress() const {
+    return mVariablesMap["metrics-address"].as<std::string>();
+}
+
+bool Config::isPipelined() const {
+    return mVariablesMap["pipeline"].as<bool>();
+}
+
+int Config::getLookahead() const {
+    return mVariablesMap["lookahead"].as<int>();
+}
+
+int Config::getMaxRateDivisor() const {
+    return mVariablesMap["max-rate-divisor"].as<int>();
+}
+
+const std::string& Config::getTraceFilename() const {
+    return mVariablesMap["trace-file"].as<std::string>();
+}
+
 const std::string& Config::getMulticastAddress() const {
     return mVariablesMap["multicast-address"].as<std::string>();
 }
 
+std::vector<TransportSpec> Config::getTransports() const {
+    return parseTransports(mVariablesMap["transport"].as<std::string>()).value_or(std::vector<TransportSpec>{});
+}
+
+void Config::validateLogFormat(const std::string& input) {
+    namespace po = boost::program_options;
+    if (input != "text" && input != "binary") {
+        throw po::validation_error(po::validation_error::invalid_option_value, "log-format", input);
+    }
+}
+
+void Config::validateLogOverflow(const std::string& input) {
+    namespace po = boost::program_options;
+    if (logOverflowMap.find(input) == logOverflowMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "log-overflow", input);
+    }
+}
+
 void Config::validateLogLevel(const std::string& input) {
     namespace po = boost::program_options;
     if (logLevelMap.find(input) == logLevelMap.end()) {
@@ -109,11 +266,25 @@ void Config::validateLogLevel(const std::string& input) {
 
 void Config::validateFps(int fps) {
     namespace po = boost::program_options;
-    if (fps < 1 || fps > 30) {
+    if (fps < 0 || fps > 1000) {
         throw po::validation_error(po::validation_error::invalid_option_value, "fps", std::to_string(fps));
     }
 }
 
+void Config::validateLookahead(int depth) {
+    namespace po = boost::program_options;
+    if (depth < 0 || depth > 256) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "lookahead", std::to_string(depth));
+    }
+}
+
+void Config::validateMaxRateDivisor(int divisor) {
+    namespace po = boost::program_options;
+    if (divisor < 1 || divisor > 64) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "max-rate-divisor", std::to_string(divisor));
+    }
+}
+
 void Config::validateGridSize(const std::string& input) {
     namespace po = boost::program_options;
     std::regex gridSizeRegex("(\\d+)x(\\d+)");
@@ -126,11 +297,28 @@ void Config::validateGridSize(const std::string& input) {
     int width = std::stoi(matches[1]);
     int height = std::stoi(matches[2]);
     
-    if (width < 10 || width > 200 || height < 10 || height > 200) {
+    if (width < 10 || width > MAX_TILED_DIMENSION || height < 10 || height > MAX_TILED_DIMENSION) {
         throw po::validation_error(po::validation_error::invalid_option_value, "grid-size", input);
     }
 }
 
+void Config::validateTileSize(const std::string& input) {
+    namespace po = boost::program_options;
+    std::regex tileSizeRegex("(\\d+)x(\\d+)");
+    std::smatch matches;
+    
+    if (!std::regex_match(input, matches, tileSizeRegex)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "tile-size", input);
+    }
+    
+    int width = std::stoi(matches[1]);
+    int height = std::stoi(matches[2]);
+    
+    if ((width == 0) != (height == 0) || width > MAX_FRAME_DIMENSION || height > MAX_FRAME_DIMENSION) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "tile-size", input);
+    }
+}
+
 void Config::validateFillRatio(float fillRatio) {
     namespace po = boost::program_options;
     if (fillRatio < 0.0f || fillRatio > 1.0f) {
@@ -138,6 +326,34 @@ void Config::validateFillRatio(float fillRatio) {
     }
 }
 
+void Config::validateBoundary(const std::string& input) {
+    namespace po = boost::program_options;
+    if (boundaryMap.find(input) == boundaryMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "boundary", input);
+    }
+}
+
+void Config::validateRule(const std::string& input) {
+    namespace po = boost::program_options;
+    if (!Rule::parse(input)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "rule", input);
+    }
+}
+
+void Config::validateEngine(const std::string& input) {
+    namespace po = boost::program_options;
+    if (engineMap.find(input) == engineMap.end()) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "engine", input);
+    }
+}
+
+void Config::validateGenerationsPerFrame(int generations) {
+    namespace po = boost::program_options;
+    if (generations < 1 || generations > 64) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "generations-per-frame", std::to_string(generations));
+    }
+}
+
 void Config::validateThreadCount(int count) {
     namespace po = boost::program_options;
     if (count < 1 || count > 64) {
@@ -154,23 +370,67 @@ void Config::validateMulticastAddress(const std::string& address) {
     }
 }
 
+void Config::validateTransports(const std::string& input) {
+    namespace po = boost::program_options;
+    auto transports = parseTransports(input);
+    if (!transports) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "transport", input);
+    }
+    for (const auto& transport : *transports) {
+        if (!Streaming::StreamingFactory::HasTransport(transport.name) || (transport.port != 0 && !isValidPort(transport.port))) {
+            throw po::validation_error(po::validation_error::invalid_option_value, "transport", input);
+        }
+    }
+}
+
+void Config::validateMetricsPort(int port) {
+    namespace po = boost::program_options;
+    if (!isValidPort(port)) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "metrics-port", std::to_string(port));
+    }
+}
+
+void Config::validateMetricsAddress(const std::string& address) {
+    namespace po = boost::program_options;
+    boost::system::error_code ec;
+    boost::asio::ip::make_address(address, ec);
+    if (ec) {
+        throw po::validation_error(po::validation_error::invalid_option_value, "metrics-address", address);
+    }
+}
+
 void Config::showCurrentConfig() const {    
     Print::PrintLine("\nServer Configuration:");
     Print::PrintLine("--------------------");
     Print::PrintLine(Print::composeMessage("Port:", getPort()));
     Print::PrintLine(Print::composeMessage("Log level:", mVariablesMap["log-level"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Log overflow:", mVariablesMap["log-overflow"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Log format:", mVariablesMap["log-format"].as<std::string>()));
     
     const auto& logFile = getLogFilename();
     Print::PrintLine(Print::composeMessage("Log file:", (logFile.empty() ? "console" : logFile)));
     
-    Print::PrintLine(Print::composeMessage("Fps:", getFps()));
+    Print::PrintLine(Print::composeMessage("Fps:", (getFps() > 0 ? std::to_string(getFps()) : "uncapped")));
     
     auto [width, height] = getGridSize();    
     Print::PrintLine(Print::composeMessage("Grid size:", width, "x", height));
+
+    auto [tileWidth, tileHeight] = getTileSize();
+    Print::PrintLine(Print::composeMessage("Tile size:", (tileWidth > 0 ? std::to_string(tileWidth) + "x" + std::to_string(tileHeight) : "disabled")));
     
     Print::PrintLine(Print::composeMessage("Fill ratio:", getFillRatio()));
+    Print::PrintLine(Print::composeMessage("Boundary:", mVariablesMap["boundary"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Rule:", getRule().toString()));
+    Print::PrintLine(Print::composeMessage("Engine:", mVariablesMap["engine"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Generations per frame:", getGenerationsPerFrame()));
     Print::PrintLine(Print::composeMessage("Thread count:", getThreadCount()));
     Print::PrintLine(Print::composeMessage("Multicast Address:", getMulticastAddress()));
+    Print::PrintLine(Print::composeMessage("Transport:", mVariablesMap["transport"].as<std::string>()));
+    Print::PrintLine(Print::composeMessage("Metrics:", (getMetricsPort() > 0 ? getMetricsAddress() + ":" + std::to_string(getMetricsPort()) : "disabled")));
+    Print::PrintLine(Print::composeMessage("Pipeline:", (isPipelined() ? "enabled" : "disabled")));
+    Print::PrintLine(Print::composeMessage("Lookahead:", (getLookahead() > 0 ? std::to_string(getLookahead()) + " generations" : "disabled")));
+    Print::PrintLine(Print::composeMessage("Adaptive rate:", (getMaxRateDivisor() > 1 ? "down to 1/" + std::to_string(getMaxRateDivisor()) + " of fps" : "disabled")));
+    Print::PrintLine(Print::composeMessage("Trace file:", (getTraceFilename().empty() ? "disabled" : getTraceFilename())));
     Print::PrintLine("--------------------");
 }
 
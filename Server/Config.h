@@ -1,15 +1,30 @@
 #pragma once
 
 #include "Log.h"
+#include "GameOfLife.h"
 #include <boost/program_options.hpp>
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace GameOfLife::Server {
 
+struct TransportSpec {
+    std::string name;
+    std::string address;
+    int port;
+};
+
 class Config
 {
+public:
+    // Whole-grid frames carry a three-digit WWWxHHH header and go out as one datagram.
+    static constexpr int MAX_FRAME_DIMENSION = 200;
+    // Tile frames carry four-digit offsets, so tiled worlds can grow past a single frame.
+    static constexpr int MAX_TILED_DIMENSION = 9999;
+    // Every tile is a frame per tick and a multicast group of its own.
+    static constexpr int MAX_TILE_COUNT = 4096;
 public:
     Config();
 public:
@@ -17,21 +32,47 @@ public:
 public:
     const std::string& getLogFilename() const;
     LogLevel getLogLevel() const;    
+    LogOverflowPolicy getLogOverflowPolicy() const;
+    bool isBinaryLog() const;
     int getPort() const;
     int getFps() const;
     std::pair<int, int> getGridSize() const;
+    std::pair<int, int> getTileSize() const;
     float getFillRatio() const;
+    GameOfLife::Boundary getBoundary() const;
+    Rule getRule() const;
+    GameOfLife::Engine getEngine() const;
+    int getGenerationsPerFrame() const;
     int getThreadCount() const;
     const std::string& getMulticastAddress() const;
+    int getMetricsPort() const;
+    const std::string& getMetricsAddress() const;
+    bool isPipelined() const;
+    int getLookahead() const;
+    int getMaxRateDivisor() const;
+    const std::string& getTraceFilename() const;
+    std::vector<TransportSpec> getTransports() const;
 private:
     void showCurrentConfig() const;
 private:
     static void validateLogLevel(const std::string& input);    
+    static void validateLogOverflow(const std::string& input);
+    static void validateLogFormat(const std::string& input);
     static void validateFps(int fps);
     static void validateGridSize(const std::string& input);
+    static void validateTileSize(const std::string& input);
     static void validateFillRatio(float ratio);
+    static void validateBoundary(const std::string& input);
+    static void validateRule(const std::string& input);
+    static void validateEngine(const std::string& input);
+    static void validateGenerationsPerFrame(int generations);
     static void validateThreadCount(int count);
+    static void validateLookahead(int depth);
+    static void validateMaxRateDivisor(int divisor);
     static void validateMulticastAddress(const std::string& address);
+    static void validateTransports(const std::string& input);
+    static void validateMetricsPort(int port);
+    static void validateMetricsAddress(const std::string& address);
 private:
     using VariablesMap = boost::program_options::variables_map;
     using Description = boost::program_options::options_description;
@@ -0,0 +1,75 @@
+#include "FramePipeline.h"
+#include "Trace.h"
+
+namespace GameOfLife::Server {
+
+FramePipeline::FramePipeline(size_t depth, EncodeStage encodeStage, BroadcastStage broadcastStage)
+    : mEncodeStage(std::move(encodeStage))
+    , mBroadcastStage(std::move(broadcastStage))
+    , mEncodeQueue(depth)
+    , mBroadcastQueue(depth)
+    // One snapshot per queue slot, one being encoded and one the simulation is filling.
+    , mFreeSnapshots(depth + 2) {
+    for (size_t index = 0; index < mFreeSnapshots.capacity(); ++index) {
+        mFreeSnapshots.push(std::make_unique<GameOfLife::Snapshot>());
+    }
+    mEncodeThread = std::jthread([this]() { runEncode(); });
+    mBroadcastThread = std::jthread([this]() { runBroadcast(); });
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+FramePipeline::SnapshotPtr FramePipeline::acquireSnapshot() {
+    SnapshotPtr snapshot;
+    mFreeSnapshots.pop(snapshot);
+    return snapshot;
+}
+
+bool FramePipeline::submit(Generation generation) {
+    return mEncodeQueue.push(std::move(generation));
+}
+
+void FramePipeline::stop() {
+    mEncodeQueue.close();
+    if (mEncodeThread.joinable()) {
+        mEncodeThread.join();
+    }
+    if (mBroadcastThread.joinable()) {
+        mBroadcastThread.join();
+    }
+}
+
+size_t FramePipeline::getEncodeBacklog() const {
+    return mEncodeQueue.size();
+}
+
+size_t FramePipeline::getBroadcastBacklog() const {
+    return mBroadcastQueue.size();
+}
+
+void FramePipeline::runEncode() {
+    TRACE_THREAD_NAME("encode");
+    Generation generation;
+    while (mEncodeQueue.pop(generation)) {
+        TRACE_SCOPE("FramePipeline::encode");
+        if (!mBroadcastQueue.push(mEncodeStage(*generation.snapshot, generation.stamp))) {
+            break;
+        }
+        mFreeSnapshots.push(std::move(generation.snapshot));
+    }
+    mBroadcastQueue.close();
+    mFreeSnapshots.close();
+}
+
+void FramePipeline::runBroadcast() {
+    TRACE_THREAD_NAME("broadcast");
+    Frames frames;
+    while (mBroadcastQueue.pop(frames)) {
+        TRACE_SCOPE("FramePipeline::broadcast");
+        mBroadcastStage(frames);
+    }
+}
+
+} // namespace GameOfLife::Server
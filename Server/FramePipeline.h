@@ -0,0 +1,58 @@
+#pragma once
+
+#include "GameOfLife.h"
+#include "FrameTrailer.h"
+#include "SpscQueue.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GameOfLife::Server {
+
+// Runs the stages of a tick on separate threads joined by bounded SPSC queues: the
+// caller simulates generation N+1 while the encode thread serializes N and the
+// broadcast thread sends N-1, so the frame interval is bounded by the slowest stage
+// instead of the sum of all three. A full queue blocks the stage feeding it, which
+// slows the simulation down to what the transports can take. Generations travel as
+// snapshots of the cell buffer that the encode thread hands back once serialized, so a
+// tick copies one buffer into memory that is already allocated.
+class FramePipeline {
+public:
+    using SnapshotPtr = std::unique_ptr<GameOfLife::Snapshot>;
+    using Frames = std::vector<std::string>;
+    using EncodeStage = std::function<Frames(const GameOfLife::Snapshot&, Streaming::FrameTrailer::Stamp)>;
+    using BroadcastStage = std::function<void(const Frames&)>;
+
+    struct Generation {
+        SnapshotPtr snapshot;
+        Streaming::FrameTrailer::Stamp stamp;
+    };
+public:
+    FramePipeline(size_t depth, EncodeStage encodeStage, BroadcastStage broadcastStage);
+    ~FramePipeline();
+public:
+    // Waits for a free snapshot while all of them are queued or being encoded, returns
+    // nullptr once the pipeline has stopped.
+    SnapshotPtr acquireSnapshot();
+    bool submit(Generation generation);
+    // Lets the queued generations drain through both stages and joins the threads.
+    void stop();
+    size_t getEncodeBacklog() const;
+    size_t getBroadcastBacklog() const;
+private:
+    void runEncode();
+    void runBroadcast();
+private:
+    EncodeStage mEncodeStage;
+    BroadcastStage mBroadcastStage;
+    SpscQueue<Generation> mEncodeQueue;
+    SpscQueue<Frames> mBroadcastQueue;
+    SpscQueue<SnapshotPtr> mFreeSnapshots;
+    std::jthread mEncodeThread;
+    std::jthread mBroadcastThread;
+};
+
+} // namespace GameOfLife::Server
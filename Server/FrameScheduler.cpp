@@ -0,0 +1,74 @@
+#include "FrameScheduler.h"
+
+#include <thread>
+
+namespace GameOfLife::Server {
+
+namespace {
+    // sleep_until wakes up to a scheduler tick late, the last stretch before a deadline
+    // is spent yielding so high frame rates keep an even cadence.
+    const std::chrono::microseconds SPIN_THRESHOLD(200);
+}
+
+FrameScheduler::FrameScheduler(int fps)
+    : mBaseInterval(fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000LL / fps)) : Clock::duration::zero())
+    , mInterval(mBaseInterval)
+    , mOverruns(0)
+    , mResyncs(0) {
+}
+
+void FrameScheduler::start() {
+    mNextDeadline = Clock::now() + mInterval;
+}
+
+FrameScheduler::FrameResult FrameScheduler::waitNextFrame() {
+    if (isUncapped()) {
+        return FrameResult::OnTime;
+    }
+
+    const auto deadline = mNextDeadline;
+    mNextDeadline += mInterval;
+
+    auto now = Clock::now();
+    if (now > deadline) {
+        ++mOverruns;
+        if (now - deadline > mInterval * MAX_CATCH_UP_FRAMES) {
+            ++mResyncs;
+            mNextDeadline = now + mInterval;
+            return FrameResult::Resynced;
+        }
+        return FrameResult::Overrun;
+    }
+
+    if (deadline - now > SPIN_THRESHOLD) {
+        std::this_thread::sleep_until(deadline - SPIN_THRESHOLD);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    return FrameResult::OnTime;
+}
+
+void FrameScheduler::setDivisor(int divisor) {
+    const auto interval = mBaseInterval * (divisor > 0 ? divisor : 1);
+    mNextDeadline += interval - mInterval;
+    mInterval = interval;
+}
+
+FrameScheduler::Clock::duration FrameScheduler::getInterval() const {
+    return mInterval;
+}
+
+bool FrameScheduler::isUncapped() const {
+    return mInterval == Clock::duration::zero();
+}
+
+uint64_t FrameScheduler::getOverruns() const {
+    return mOverruns;
+}
+
+uint64_t FrameScheduler::getResyncs() const {
+    return mResyncs;
+}
+
+} // namespace GameOfLife::Server
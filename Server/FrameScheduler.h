@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace GameOfLife::Server {
+
+// Paces the simulation loop on absolute steady clock deadlines, start + n * interval,
+// so the time spent computing and broadcasting a frame comes out of the wait instead
+// of adding to it. A tick that ends past its deadline is an overrun and the next one
+// starts right away to catch up; once the loop is more than MAX_CATCH_UP_FRAMES
+// behind, the schedule restarts from now rather than bursting out the missed frames.
+// setDivisor stretches the interval to a fraction of the configured frame rate.
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class FrameResult {
+        OnTime,
+        Overrun,
+        Resynced
+    };
+public:
+    // 0 fps runs uncapped, every wait returns immediately.
+    explicit FrameScheduler(int fps);
+public:
+    void start();
+    FrameResult waitNextFrame();
+    // Emits one frame every divisor intervals of the configured rate, from the next deadline on.
+    void setDivisor(int divisor);
+    Clock::duration getInterval() const;
+    bool isUncapped() const;
+    uint64_t getOverruns() const;
+    uint64_t getResyncs() const;
+private:
+    static constexpr int MAX_CATCH_UP_FRAMES = 4;
+private:
+    Clock::duration mBaseInterval;
+    Clock::duration mInterval;
+    Clock::time_point mNextDeadline;
+    uint64_t mOverruns;
+    uint64_t mResyncs;
+};
+
+} // namespace GameOfLife::Server
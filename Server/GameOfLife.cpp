@@ -1,99 +1,404 @@
 #include "GameOfLife.h"
+#include "Trace.h"
 #include <random>
 #include <chrono>
 #include <sstream>
 #include <iomanip> // Required for std::setw and std::setfill
+#include <algorithm>
+#include <array>
+#include <utility>
 
 namespace GameOfLife::Server {
 
 namespace {
     std::random_device gRandomDevice;
     std::mt19937 gRandomGenerator = std::mt19937(gRandomDevice());
+
+    constexpr Rule HIGHLIFE_RULE = *Rule::parse("B36/S23");
+    constexpr Rule DAY_AND_NIGHT_RULE = *Rule::parse("B3678/S34678");
+    constexpr Rule SEEDS_RULE = *Rule::parse("B2/S");
+    constexpr Rule LIFE_WITHOUT_DEATH_RULE = *Rule::parse("B3/S012345678");
+    constexpr Rule MAZE_RULE = *Rule::parse("B3/S12345");
+
+    using NeighborCounts = std::make_integer_sequence<int, 9>;
+
+    // One comparison per neighbor count set in Mask. Mask is a template constant, so the
+    // unset counts fold away and B3/S23 compiles to the same (n == 3) | (n == 2) tests
+    // as a hand-written Conway kernel, without lookups that would stop vectorization.
+    template <uint16_t Mask, int... Counts>
+    uint8_t matchesAny(int neighbors, std::integer_sequence<int, Counts...>) {
+        return static_cast<uint8_t>((0 | ... | (((Mask >> Counts) & 1) & (neighbors == Counts))));
+    }
+
+    // Cells are in the padded layout, the first grid cell sits one row and one column in.
+    std::string composeFrame(const std::vector<uint8_t>& cells, int stride, int x, int y, int width, int height) {
+        TRACE_SCOPE("GameOfLife::toString");
+        std::ostringstream ss;
+        ss << std::setw(3) << std::setfill('0') << width 
+           << 'x' 
+           << std::setw(3) << std::setfill('0') << height;
+
+        for (int row = y; row < y + height; ++row) {
+            const uint8_t* cell = &cells[static_cast<size_t>(row + 1) * stride + (x + 1)];
+            for (int column = 0; column < width; ++column) {
+                ss << (cell[column] ? '#' : ' ');
+            }
+        }
+
+        ss << "\n";
+
+        return ss.str();
+    }
 }
 
-GameOfLife::GameOfLife(int width, int height)
-    : mWidth(width)
+GameOfLife::GameOfLife(int width, int height, Boundary boundary, Rule rule)
+    : mCells(static_cast<size_t>(width + 2) * (height + 2), 0)
+    , mNextCells(mCells.size(), 0)
+    , mWidth(width)
     , mHeight(height) 
+    , mStride(width + 2)
+    , mBoundary(boundary)
+    , mRule(rule)
+    , mRowKernel(nullptr)
+    , mEngine(Engine::Scalar)
+    , mWorkers(std::make_unique<BandWorkers>(1))
+    , mBandScratch(2)
 {
-    mGrid.resize(mHeight, std::vector<bool>(mWidth, false));
+    selectKernel();
 }
 
 void GameOfLife::initializeRandom(float fillRatio) {
+    fillRandom(fillRatio, gRandomGenerator);
+}
+
+void GameOfLife::initializeRandom(float fillRatio, uint32_t seed) {
+    std::mt19937 generator(seed);
+    fillRandom(fillRatio, generator);
+}
+
+void GameOfLife::fillRandom(float fillRatio, std::mt19937& generator) {
     std::uniform_real_distribution<float> dist(0.0f, 1.0f);
     for (int y = 0; y < mHeight; ++y) {
         for (int x = 0; x < mWidth; ++x) {
-            mGrid[y][x] = (dist(gRandomGenerator) < fillRatio);
+            mCells[index(x, y)] = (dist(generator) < fillRatio);
+        }
+    }
+}
+
+void GameOfLife::setThreadCount(int threadCount) {
+    threadCount = std::max(1, threadCount);
+    if (threadCount != mWorkers->getThreadCount()) {
+        mWorkers = std::make_unique<BandWorkers>(threadCount);
+        mBandScratch.resize(2 * static_cast<size_t>(threadCount));
+    }
+}
+
+void GameOfLife::setEngine(Engine engine) {
+    mEngine = engine;
+    if (mEngine == Engine::Lookup && !mBlockTable) {
+        mBlockTable = buildBlockTable(mRule);
+    }
+}
+
+const Rule& GameOfLife::getRule() const {
+    return mRule;
+}
+
+bool GameOfLife::hasSpecializedKernel() const {
+    return mRowKernel != &GameOfLife::updateRowsGeneric;
+}
+
+void GameOfLife::selectKernel() {
+    using Kernel = std::pair<Rule, RowKernel>;
+    static constexpr std::array SPECIALIZED_KERNELS {
+        Kernel{ CONWAY_RULE, &GameOfLife::updateRows<CONWAY_RULE> },
+        Kernel{ HIGHLIFE_RULE, &GameOfLife::updateRows<HIGHLIFE_RULE> },
+        Kernel{ DAY_AND_NIGHT_RULE, &GameOfLife::updateRows<DAY_AND_NIGHT_RULE> },
+        Kernel{ SEEDS_RULE, &GameOfLife::updateRows<SEEDS_RULE> },
+        Kernel{ LIFE_WITHOUT_DEATH_RULE, &GameOfLife::updateRows<LIFE_WITHOUT_DEATH_RULE> },
+        Kernel{ MAZE_RULE, &GameOfLife::updateRows<MAZE_RULE> }
+    };
+
+    mRowKernel = &GameOfLife::updateRowsGeneric;
+    for (const auto& [rule, kernel] : SPECIALIZED_KERNELS) {
+        if (rule == mRule) {
+            mRowKernel = kernel;
         }
     }
 }
 
 void GameOfLife::update() {
-    auto newGrid = mGrid;
-    for (int y = 0; y < mHeight; ++y) {
-        for (int x = 0; x < mWidth; ++x) {
-            int neighbors = countLivingNeighbors(x, y);
-            bool currentlyAlive = mGrid[y][x];
-            
-            // Apply the rules of Conway's Game of Life:
-            // 1. Any live cell with fewer than two live neighbors dies (underpopulation)
-            // 2. Any live cell with two or three live neighbors lives on
-            // 3. Any live cell with more than three live neighbors dies (overpopulation)
-            // 4. Any dead cell with exactly three live neighbors becomes a live cell (reproduction)
-            
-            if (currentlyAlive) {
-                newGrid[y][x] = (neighbors == 2 || neighbors == 3);
-            } else {
-                newGrid[y][x] = (neighbors == 3);
+    TRACE_SCOPE("GameOfLife::update");
+    refreshHalo();
+    // Rows are split into contiguous bands, every thread writes only the rows of its own band.
+    // Band borders fall on even rows so the Lookup engine never splits a 2x2 block.
+    const int bandCount = std::min(mWorkers->getThreadCount(), mHeight / 2);
+    if (bandCount <= 1) {
+        updateBand(0, mHeight);
+    }
+    else {
+        auto bandStart = [this, bandCount](int band) {
+            return band == bandCount ? mHeight : (mHeight * band / bandCount) & ~1;
+        };
+        mWorkers->run(bandCount, [this, &bandStart](int band) {
+            updateBand(bandStart(band), bandStart(band + 1));
+        });
+    }
+    
+    // The halo of the next buffer is stale, refreshHalo rewrites it before it is read.
+    mCells.swap(mNextCells);
+}
+
+void GameOfLife::advance(int generations) {
+    if (mEngine != Engine::Tiled) {
+        for (int generation = 0; generation < generations; ++generation) {
+            update();
+        }
+        return;
+    }
+
+    TRACE_SCOPE("GameOfLife::advance");
+    while (generations > 0) {
+        const int depth = std::min(generations, MAX_TEMPORAL_DEPTH);
+        if (depth == 1) {
+            update();
+        }
+        else {
+            advanceTiled(depth);
+        }
+        generations -= depth;
+    }
+}
+
+void GameOfLife::advanceTiled(int depth) {
+    refreshHalo();
+    // Every band is read with depth extra rows on both sides, which pays for the rows the
+    // trapezoid loses per generation; bands are kept at least 4 * depth rows tall so that
+    // redundant work stays below half of the band even for very wide grids.
+    const int bandRows = std::max(4 * depth, static_cast<int>(BAND_BYTES / (2 * mStride)) - 2 * depth);
+    const int bandCount = (mHeight + bandRows - 1) / bandRows;
+    const int workerCount = std::min(mWorkers->getThreadCount(), bandCount);
+    mWorkers->run(workerCount, [this, depth, bandRows, bandCount, workerCount](int worker) {
+        Cells& scratch = mBandScratch[2 * static_cast<size_t>(worker)];
+        Cells& nextScratch = mBandScratch[2 * static_cast<size_t>(worker) + 1];
+        for (int band = worker; band < bandCount; band += workerCount) {
+            const int firstRow = band * bandRows;
+            advanceBand(firstRow, std::min(firstRow + bandRows, mHeight), depth, scratch, nextScratch);
+        }
+    });
+
+    mCells.swap(mNextCells);
+}
+
+void GameOfLife::advanceBand(int firstRow, int lastRow, int depth, Cells& scratch, Cells& nextScratch) {
+    TRACE_SCOPE("GameOfLife::advanceBand");
+    // Scratch row r holds grid row firstRow - depth + r in the same padded layout as mCells,
+    // so the row kernels run on it unchanged. Generation g is valid on rows [g, rows - g).
+    const int rows = lastRow - firstRow + 2 * depth;
+    const size_t size = static_cast<size_t>(rows + 2) * mStride;
+    scratch.resize(size);
+    nextScratch.resize(size);
+
+    auto isOutside = [this](int y) { return y < 0 || y >= mHeight; };
+    for (int row = 0; row < rows; ++row) {
+        const int y = firstRow - depth + row;
+        uint8_t* destination = &scratch[index(-1, row)];
+        if (mBoundary == Boundary::Torus) {
+            const int wrapped = ((y % mHeight) + mHeight) % mHeight;
+            std::copy_n(&mCells[index(-1, wrapped)], mStride, destination);
+        }
+        else if (isOutside(y)) {
+            std::fill_n(destination, mStride, 0);
+        }
+        else {
+            std::copy_n(&mCells[index(-1, y)], mStride, destination);
+        }
+    }
+
+    for (int generation = 1; generation <= depth; ++generation) {
+        (this->*mRowKernel)(scratch, nextScratch, generation, rows - generation);
+        for (int row = generation; row < rows - generation; ++row) {
+            if (mBoundary == Boundary::Torus) {
+                nextScratch[index(-1, row)] = nextScratch[index(mWidth - 1, row)];
+                nextScratch[index(mWidth, row)] = nextScratch[index(0, row)];
+            }
+            else if (isOutside(firstRow - depth + row)) {
+                // Rows past a dead edge stay dead whatever the rule would grow there. The
+                // column halo of the other rows is never written and stays zero.
+                std::fill_n(&nextScratch[index(-1, row)], mStride, 0);
             }
         }
+        scratch.swap(nextScratch);
+    }
+
+    for (int row = depth; row < rows - depth; ++row) {
+        std::copy_n(&scratch[index(0, row)], mWidth, &mNextCells[index(0, firstRow - depth + row)]);
     }
-    
-    mGrid = std::move(newGrid);
 }
 
-std::string GameOfLife::toString() const {
-    std::ostringstream ss;
-    ss << std::setw(3) << std::setfill('0') << mWidth 
-       << 'x' 
-       << std::setw(3) << std::setfill('0') << mHeight;
+void GameOfLife::refreshHalo() {
+    if (mBoundary == Boundary::Dead) {
+        // Nothing ever writes the halo, it stays as zeroed by the constructor.
+        return;
+    }
 
-    for (int y = 0; y < mHeight; ++y) {
-        for (int x = 0; x < mWidth; ++x) {
-            ss << (mGrid[y][x] ? '#' : ' ');
+    std::copy_n(&mCells[index(0, mHeight - 1)], mWidth, &mCells[index(0, -1)]);
+    std::copy_n(&mCells[index(0, 0)], mWidth, &mCells[index(0, mHeight)]);
+    for (int y = -1; y <= mHeight; ++y) {
+        mCells[index(-1, y)] = mCells[index(mWidth - 1, y)];
+        mCells[index(mWidth, y)] = mCells[index(0, y)];
+    }
+}
+
+void GameOfLife::updateBand(int firstRow, int lastRow) {
+    if (mEngine == Engine::Lookup) {
+        updateBlocks(firstRow, lastRow);
+    }
+    else {
+        (this->*mRowKernel)(mCells, mNextCells, firstRow, lastRow);
+    }
+}
+
+template <Rule RuleValue>
+void GameOfLife::updateRows(const Cells& source, Cells& target, int firstRow, int lastRow) const {
+    // Counts in both masks decide regardless of the cell state, so rules where birth is a
+    // subset of survival, Conway's included, need no state test for the birth part.
+    constexpr uint16_t EITHER = RuleValue.birth & RuleValue.survival;
+    constexpr uint16_t SURVIVAL_ONLY = RuleValue.survival & ~RuleValue.birth;
+    constexpr uint16_t BIRTH_ONLY = RuleValue.birth & ~RuleValue.survival;
+    updateRowsWith(source, target, firstRow, lastRow, [](int neighbors, uint8_t alive) {
+        return static_cast<uint8_t>(matchesAny<EITHER>(neighbors, NeighborCounts{})
+                                    | (alive & matchesAny<SURVIVAL_ONLY>(neighbors, NeighborCounts{}))
+                                    | ((alive ^ 1) & matchesAny<BIRTH_ONLY>(neighbors, NeighborCounts{})));
+    });
+}
+
+void GameOfLife::updateRowsGeneric(const Cells& source, Cells& target, int firstRow, int lastRow) const {
+    const unsigned birth = mRule.birth;
+    const unsigned survival = mRule.survival;
+    updateRowsWith(source, target, firstRow, lastRow, [birth, survival](int neighbors, uint8_t alive) {
+        return static_cast<uint8_t>((((birth >> neighbors) & (alive ^ 1)) | ((survival >> neighbors) & alive)) & 1);
+    });
+}
+
+template <typename CellRule>
+void GameOfLife::updateRowsWith(const Cells& source, Cells& target, int firstRow, int lastRow, CellRule cellRule) const {
+    TRACE_SCOPE("GameOfLife::updateRows");
+    // A local copy, the byte stores below could alias mWidth and keep the loop from vectorizing.
+    const int width = mWidth;
+    for (int y = firstRow; y < lastRow; ++y) {
+        const uint8_t* above = &source[index(0, y - 1)];
+        const uint8_t* row = &source[index(0, y)];
+        const uint8_t* below = &source[index(0, y + 1)];
+        uint8_t* next = &target[index(0, y)];
+        for (int x = 0; x < width; ++x) {
+            const int neighbors = above[x - 1] + above[x] + above[x + 1]
+                                + row[x - 1] + row[x + 1]
+                                + below[x - 1] + below[x] + below[x + 1];
+            next[x] = cellRule(neighbors, row[x]);
         }
     }
+}
 
-    ss << "\n";
+void GameOfLife::updateBlocks(int firstRow, int lastRow) {
+    TRACE_SCOPE("GameOfLife::updateBlocks");
+    const BlockTable& table = *mBlockTable;
+    const int width = mWidth;
+    int y = firstRow;
+    for (; y + 1 < lastRow; y += 2) {
+        const uint8_t* rows[4] = { &mCells[index(0, y - 1)], &mCells[index(0, y)], &mCells[index(0, y + 1)], &mCells[index(0, y + 2)] };
+        uint8_t* top = &mNextCells[index(0, y)];
+        uint8_t* bottom = &mNextCells[index(0, y + 1)];
 
-    return ss.str();
+        // The table index holds four columns of each of the four rows, the leftmost column
+        // in the high bit of each nibble. Moving one block to the right drops the two left
+        // columns and shifts in the next two, so every cell is loaded once per block row.
+        auto columnPair = [&rows](int row, int x) {
+            return static_cast<unsigned>((rows[row][x] << 1) | rows[row][x + 1]) << ((3 - row) * 4);
+        };
+        unsigned neighborhood = columnPair(0, -1) | columnPair(1, -1) | columnPair(2, -1) | columnPair(3, -1);
+        for (int x = 0; x + 1 < width; x += 2) {
+            neighborhood = ((neighborhood << 2) & 0xCCCC)
+                         | columnPair(0, x + 1) | columnPair(1, x + 1) | columnPair(2, x + 1) | columnPair(3, x + 1);
+            const uint8_t next = table[neighborhood];
+            top[x] = (next >> 3) & 1;
+            top[x + 1] = (next >> 2) & 1;
+            bottom[x] = (next >> 1) & 1;
+            bottom[x + 1] = next & 1;
+        }
+        if (width % 2 != 0) {
+            top[width - 1] = nextState(width - 1, y);
+            bottom[width - 1] = nextState(width - 1, y + 1);
+        }
+    }
+    // An odd last row has no partner for a block.
+    if (y < lastRow) {
+        (this->*mRowKernel)(mCells, mNextCells, y, lastRow);
+    }
 }
 
-int GameOfLife::countLivingNeighbors(int x, int y) const {
-    int count = 0;
-    
+uint8_t GameOfLife::nextState(int x, int y) const {
+    int neighbors = 0;
     for (int dy = -1; dy <= 1; ++dy) {
         for (int dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0) {
-                continue;
-            }
-            
-            if (isAlive(x + dx, y + dy)) {
-                count++;
+            neighbors += (dx != 0 || dy != 0) ? mCells[index(x + dx, y + dy)] : 0;
+        }
+    }
+    const uint16_t mask = mCells[index(x, y)] ? mRule.survival : mRule.birth;
+    return static_cast<uint8_t>((mask >> neighbors) & 1);
+}
+
+GameOfLife::BlockTablePtr GameOfLife::buildBlockTable(const Rule& rule) {
+    // Index bits, high to low: rows 0-3 of the 4x4 neighborhood, each as four columns
+    // with the leftmost in the high bit. Result bits 3-0: top left, top right, bottom
+    // left and bottom right of the 2x2 center.
+    auto table = std::make_shared<BlockTable>();
+    for (unsigned neighborhood = 0; neighborhood < table->size(); ++neighborhood) {
+        auto cell = [neighborhood](int row, int column) {
+            return (neighborhood >> ((3 - row) * 4 + (3 - column))) & 1;
+        };
+        uint8_t next = 0;
+        for (int row = 1; row <= 2; ++row) {
+            for (int column = 1; column <= 2; ++column) {
+                int neighbors = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        neighbors += (dx != 0 || dy != 0) ? cell(row + dy, column + dx) : 0;
+                    }
+                }
+                const uint16_t mask = cell(row, column) ? rule.survival : rule.birth;
+                next = static_cast<uint8_t>((next << 1) | ((mask >> neighbors) & 1));
             }
         }
+        (*table)[neighborhood] = next;
     }
-    
-    return count;
+    return table;
 }
 
-bool GameOfLife::isAlive(int x, int y) const {
-    if (x < 0) x = mWidth - 1;
-    else if (x >= mWidth) x = 0;
-    
-    if (y < 0) y = mHeight - 1;
-    else if (y >= mHeight) y = 0;
-    
-    return mGrid[y][x];
+std::string GameOfLife::toString() const {
+    return toString(0, 0, mWidth, mHeight);
+}
+
+std::string GameOfLife::toString(int x, int y, int width, int height) const {
+    return composeFrame(mCells, mStride, x, y, width, height);
+}
+
+void GameOfLife::takeSnapshot(Snapshot& snapshot) const {
+    snapshot.mCells.assign(mCells.begin(), mCells.end());
+    snapshot.mWidth = mWidth;
+    snapshot.mHeight = mHeight;
+}
+
+std::string GameOfLife::Snapshot::toString() const {
+    return toString(0, 0, mWidth, mHeight);
+}
+
+std::string GameOfLife::Snapshot::toString(int x, int y, int width, int height) const {
+    return composeFrame(mCells, mWidth + 2, x, y, width, height);
+}
+
+size_t GameOfLife::index(int x, int y) const {
+    return static_cast<size_t>(y + 1) * mStride + (x + 1);
 }
 
 } // namespace GameOfLife::Server
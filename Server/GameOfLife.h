@@ -1,28 +1,111 @@
 #pragma once
 
+#include "BandWorkers.h"
+#include "Rule.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include <random>
 
 namespace GameOfLife::Server {
 
+// Cells live in one contiguous buffer of (width + 2) x (height + 2) bytes, one alive
+// flag per byte, with a one cell halo around the grid. Before each generation the halo
+// is refreshed from the opposite edges (Torus) or left dead (Dead), so every interior
+// cell reads its eight neighbors without any bounds checks. The rule is fixed at
+// construction: common rules run a kernel instantiated for their masks, anything
+// else runs a generic kernel that reads the masks at runtime. The Lookup engine
+// instead walks the grid in 2x2 blocks and maps each 4x4 neighborhood to its next
+// 2x2 center through a 65536 entry table built for the rule. The Tiled engine makes
+// advance() compute several generations per cache-sized band of rows before moving
+// on to the next band, instead of streaming the whole grid once per generation.
+// Bands of a generation or pass are spread over persistent BandWorkers threads.
 class GameOfLife {
 public:
-    GameOfLife(int width, int height);
+    enum class Boundary {
+        Torus,
+        Dead
+    };
+
+    enum class Engine {
+        Scalar,
+        Lookup,
+        Tiled
+    };
+
+    // Copy of one generation's cell buffer, serialized on another thread while the
+    // simulation moves on. Taking a snapshot into the same object again reuses its buffer.
+    class Snapshot {
+    public:
+        std::string toString() const;
+        std::string toString(int x, int y, int width, int height) const;
+    private:
+        friend class GameOfLife;
+        std::vector<uint8_t> mCells;
+        int mWidth = 0;
+        int mHeight = 0;
+    };
+public:
+    GameOfLife(int width, int height, Boundary boundary = Boundary::Torus, Rule rule = CONWAY_RULE);
 public:
     void initializeRandom(float fillRatio = 0.3f);
+    // Same cells for the same seed, to run several engines on one starting grid.
+    void initializeRandom(float fillRatio, uint32_t seed);
+    void setThreadCount(int threadCount);
+    void setEngine(Engine engine);
+    const Rule& getRule() const;
+    bool hasSpecializedKernel() const;
 public:
     void update();
+    void advance(int generations);
     std::string toString() const;
+    std::string toString(int x, int y, int width, int height) const;
+    void takeSnapshot(Snapshot& snapshot) const;
+private:
+    void fillRandom(float fillRatio, std::mt19937& generator);
+    void refreshHalo();
+    void updateBand(int firstRow, int lastRow);
+    void advanceTiled(int depth);
+    void advanceBand(int firstRow, int lastRow, int depth, std::vector<uint8_t>& scratch, std::vector<uint8_t>& nextScratch);
+    void selectKernel();
+    template <Rule RuleValue>
+    void updateRows(const std::vector<uint8_t>& source, std::vector<uint8_t>& target, int firstRow, int lastRow) const;
+    void updateRowsGeneric(const std::vector<uint8_t>& source, std::vector<uint8_t>& target, int firstRow, int lastRow) const;
+    template <typename CellRule>
+    void updateRowsWith(const std::vector<uint8_t>& source, std::vector<uint8_t>& target, int firstRow, int lastRow, CellRule cellRule) const;
+    void updateBlocks(int firstRow, int lastRow);
+    uint8_t nextState(int x, int y) const;
+    size_t index(int x, int y) const;
+private:
+    using Cells = std::vector<uint8_t>;
+    using RowKernel = void (GameOfLife::*)(const Cells& source, Cells& target, int firstRow, int lastRow) const;
+    using BlockTable = std::array<uint8_t, 65536>;
+    using BlockTablePtr = std::shared_ptr<const BlockTable>;
+    using BandWorkersPtr = std::unique_ptr<BandWorkers>;
 private:
-    int countLivingNeighbors(int x, int y) const;
-    bool isAlive(int x, int y) const;
+    static BlockTablePtr buildBlockTable(const Rule& rule);
 private:
-    using Grid = std::vector<std::vector<bool>>;
+    // Deepest trapezoid of one advanceTiled pass, longer advances run several passes.
+    static constexpr int MAX_TEMPORAL_DEPTH = 8;
+    // Both scratch buffers of a band together, sized to stay within a 1-2 MiB L2 cache.
+    static constexpr size_t BAND_BYTES = 512 * 1024;
 private:
-    Grid mGrid;
+    Cells mCells;
+    Cells mNextCells;
     int mWidth;
     int mHeight;
+    int mStride;
+    Boundary mBoundary;
+    Rule mRule;
+    RowKernel mRowKernel;
+    Engine mEngine;
+    BlockTablePtr mBlockTable;
+    BandWorkersPtr mWorkers;
+    // Two advanceBand buffers per worker, kept between passes.
+    std::vector<Cells> mBandScratch;
 };
 
 } // namespace GameOfLife::Server
@@ -0,0 +1,57 @@
+#include "LookaheadBuffer.h"
+#include "Trace.h"
+
+namespace GameOfLife::Server {
+
+LookaheadBuffer::LookaheadBuffer(size_t depth, Producer producer)
+    : mProducer(std::move(producer))
+    , mFrames(depth)
+    , mProduceTimeNs(0)
+    , mThread([this]() { run(); }) {
+}
+
+LookaheadBuffer::~LookaheadBuffer() {
+    stop();
+}
+
+bool LookaheadBuffer::tryTake(Frames& frames) {
+    return mFrames.tryPop(frames);
+}
+
+void LookaheadBuffer::stop() {
+    mFrames.close();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+size_t LookaheadBuffer::getDepth() const {
+    return mFrames.capacity();
+}
+
+size_t LookaheadBuffer::getOccupancy() const {
+    return mFrames.size();
+}
+
+std::chrono::nanoseconds LookaheadBuffer::getProduceTime() const {
+    return std::chrono::nanoseconds(mProduceTimeNs.load(std::memory_order_relaxed));
+}
+
+void LookaheadBuffer::run() {
+    TRACE_THREAD_NAME("lookahead");
+    while (true) {
+        Frames frames;
+        {
+            TRACE_SCOPE("LookaheadBuffer::produce");
+            const auto produceStart = std::chrono::steady_clock::now();
+            frames = mProducer();
+            const auto produceTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - produceStart);
+            mProduceTimeNs.store(produceTime.count(), std::memory_order_relaxed);
+        }
+        if (!mFrames.push(std::move(frames))) {
+            break;
+        }
+    }
+}
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GameOfLife::Server {
+
+// Ring of encoded generations computed ahead of the broadcast clock. A producer thread
+// simulates and serializes as fast as it can until depth generations are waiting, the
+// frame loop takes one per deadline. A slow generation then only eats into the frames
+// already buffered instead of delaying the broadcast, as long as the simulation keeps
+// up on average.
+class LookaheadBuffer {
+public:
+    using Frames = std::vector<std::string>;
+    using Producer = std::function<Frames()>;
+public:
+    LookaheadBuffer(size_t depth, Producer producer);
+    ~LookaheadBuffer();
+public:
+    // Never waits, false means the producer has not finished the next generation yet.
+    bool tryTake(Frames& frames);
+    // Stops the producer after the generation it is computing and joins its thread.
+    void stop();
+    size_t getDepth() const;
+    size_t getOccupancy() const;
+    // Time the producer spent on its most recent generation.
+    std::chrono::nanoseconds getProduceTime() const;
+private:
+    void run();
+private:
+    Producer mProducer;
+    SpscQueue<Frames> mFrames;
+    std::atomic<int64_t> mProduceTimeNs;
+    std::jthread mThread;
+};
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,139 @@
+#include "MetricsEndpoint.h"
+#include "Metrics.h"
+#include "Log.h"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+namespace GameOfLife::Server {
+
+namespace {
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+
+    const char* METRICS_PATH = "/metrics";
+    const char* METRICS_CONTENT_TYPE = "text/plain; version=0.0.4";
+    const std::chrono::seconds REQUEST_TIMEOUT(10);
+
+    // One scrape connection, kept alive for as long as the scraper wants.
+    class HttpSession : public std::enable_shared_from_this<HttpSession> {
+    public:
+        explicit HttpSession(boost::asio::ip::tcp::socket&& socket)
+            : mStream(std::move(socket)) {
+        }
+    public:
+        void read() {
+            mRequest = {};
+            mStream.expires_after(REQUEST_TIMEOUT);
+            http::async_read(mStream, mBuffer, mRequest,
+                [self = shared_from_this()](beast::error_code ec, size_t) {
+                    if (ec) {
+                        if (ec != http::error::end_of_stream) {
+                            Log::Debug("Metrics request read failed: {}", ec.message());
+                        }
+                        self->close();
+                        return;
+                    }
+                    self->respond();
+                });
+        }
+    private:
+        void respond() {
+            auto response = std::make_shared<http::response<http::string_body>>();
+            response->version(mRequest.version());
+            response->keep_alive(mRequest.keep_alive());
+            if (mRequest.method() != http::verb::get) {
+                response->result(http::status::method_not_allowed);
+                response->set(http::field::allow, "GET");
+            }
+            else if (mRequest.target() != METRICS_PATH) {
+                response->result(http::status::not_found);
+            }
+            else {
+                response->result(http::status::ok);
+                response->set(http::field::content_type, METRICS_CONTENT_TYPE);
+                response->body() = Metrics::Registry::Get().serialize();
+            }
+            response->prepare_payload();
+
+            http::async_write(mStream, *response,
+                [self = shared_from_this(), response](beast::error_code ec, size_t) {
+                    if (ec || !response->keep_alive()) {
+                        self->close();
+                        return;
+                    }
+                    self->read();
+                });
+        }
+
+        void close() {
+            beast::error_code ec;
+            mStream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+        }
+    private:
+        beast::tcp_stream mStream;
+        beast::flat_buffer mBuffer;
+        http::request<http::string_body> mRequest;
+    };
+}
+
+MetricsEndpoint::MetricsEndpoint()
+    : mAcceptor(mIoContext)
+    , mRunning(false) {
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+    stop();
+}
+
+bool MetricsEndpoint::start(const std::string& address, int port) {
+    try {
+        boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::make_address(address), static_cast<unsigned short>(port));
+        mAcceptor.open(endpoint.protocol());
+        mAcceptor.set_option(boost::asio::socket_base::reuse_address(true));
+        mAcceptor.bind(endpoint);
+        mAcceptor.listen();
+    }
+    catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Failed to start metrics endpoint on", address + ":" + std::to_string(port), "-", e.what()));
+        return false;
+    }
+
+    mRunning = true;
+    mWorkGuard = std::make_unique<WorkGuard>(mIoContext.get_executor());
+    accept();
+    mThread = std::jthread([this]() { mIoContext.run(); });
+    Log::Info("Metrics available at http://" + address + ":" + std::to_string(port) + METRICS_PATH);
+    return true;
+}
+
+void MetricsEndpoint::stop() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    mWorkGuard.reset();
+    mIoContext.stop();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    boost::system::error_code ec;
+    mAcceptor.close(ec);
+    Log::Info("Metrics endpoint stopped");
+}
+
+void MetricsEndpoint::accept() {
+    mAcceptor.async_accept([this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+        if (!mRunning) {
+            return;
+        }
+        if (ec) {
+            Log::Warning(Print::composeMessage("Metrics endpoint accept failed:", ec.message()));
+        }
+        else {
+            std::make_shared<HttpSession>(std::move(socket))->read();
+        }
+        accept();
+    });
+}
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace GameOfLife::Server {
+
+// Minimal HTTP/1.1 server answering GET /metrics with the Prometheus text format of
+// the process wide metrics registry. Runs on its own thread so a slow scraper never
+// delays the simulation loop.
+class MetricsEndpoint {
+public:
+    MetricsEndpoint();
+    ~MetricsEndpoint();
+public:
+    bool start(const std::string& address, int port);
+    void stop();
+private:
+    void accept();
+private:
+    using IoContext = boost::asio::io_context;
+    using TcpAcceptor = boost::asio::ip::tcp::acceptor;
+    using WorkGuard = boost::asio::executor_work_guard<IoContext::executor_type>;
+    using WorkGuardPtr = std::unique_ptr<WorkGuard>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    IoContext mIoContext;
+    TcpAcceptor mAcceptor;
+    WorkGuardPtr mWorkGuard;
+    std::jthread mThread;
+    AtomicFlag mRunning;
+};
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,43 @@
+#include "RateController.h"
+
+#include <algorithm>
+
+namespace GameOfLife::Server {
+
+RateController::RateController(int maxDivisor)
+    : mMaxDivisor(std::max(maxDivisor, 1))
+    , mDivisor(1)
+    , mFramesSinceChange(0)
+    , mLoad(0.0) {
+}
+
+RateController::Decision RateController::observe(double load) {
+    mLoad = mFramesSinceChange == 0 ? load : mLoad + SMOOTHING * (load - mLoad);
+    if (++mFramesSinceChange < SETTLE_FRAMES) {
+        return Decision::Keep;
+    }
+
+    if (mLoad > OVERLOAD && mDivisor < mMaxDivisor) {
+        mDivisor = std::min(mDivisor * 2, mMaxDivisor);
+        mFramesSinceChange = 0;
+        return Decision::SlowDown;
+    }
+    // Halving the divisor halves the interval, so the same work costs twice the load.
+    const int fasterDivisor = mDivisor / 2;
+    if (fasterDivisor >= 1 && mLoad * mDivisor / fasterDivisor < RECOVERY) {
+        mDivisor = fasterDivisor;
+        mFramesSinceChange = 0;
+        return Decision::SpeedUp;
+    }
+    return Decision::Keep;
+}
+
+int RateController::getDivisor() const {
+    return mDivisor;
+}
+
+double RateController::getLoad() const {
+    return mLoad;
+}
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace GameOfLife::Server {
+
+// Decides how far to divide the configured frame rate when ticks keep running over
+// their budget. Each frame reports its load, the busy part of the frame interval;
+// once the smoothed load stays above 1 the divisor doubles, and it halves again when
+// the load projected for the faster rate leaves enough headroom. Changes are spaced
+// at least SETTLE_FRAMES frames apart so a single slow tick does not move the rate.
+class RateController {
+public:
+    enum class Decision {
+        Keep,
+        SlowDown,
+        SpeedUp
+    };
+public:
+    explicit RateController(int maxDivisor);
+public:
+    Decision observe(double load);
+    int getDivisor() const;
+    double getLoad() const;
+private:
+    static constexpr int SETTLE_FRAMES = 20;
+    static constexpr double SMOOTHING = 0.1;
+    static constexpr double OVERLOAD = 1.0;
+    static constexpr double RECOVERY = 0.7;
+private:
+    int mMaxDivisor;
+    int mDivisor;
+    int mFramesSinceChange;
+    double mLoad;
+};
+
+} // namespace GameOfLife::Server
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace GameOfLife::Server {
+
+// Life-like rule in B/S notation. Bit n of birth is set when a dead cell with n living
+// neighbors is born, bit n of survival when a living cell with n neighbors lives on,
+// so Conway's B3/S23 is birth 0b1000 and survival 0b1100. Parsing is constexpr so the
+// rules with specialized kernels can be spelled as rulestrings at compile time.
+struct Rule {
+    uint16_t birth;
+    uint16_t survival;
+
+    static constexpr std::optional<Rule> parse(std::string_view text);
+    std::string toString() const;
+
+    constexpr bool operator==(const Rule& other) const = default;
+};
+
+inline constexpr Rule CONWAY_RULE{ 1 << 3, (1 << 2) | (1 << 3) };
+
+constexpr std::optional<Rule> Rule::parse(std::string_view text) {
+    // B<digits>/S<digits>, either letter in any case, each part may be empty ("B2/S").
+    auto parseCounts = [](std::string_view part, char letter) -> std::optional<uint16_t> {
+        if (part.empty() || (part.front() != letter && part.front() != letter - 'A' + 'a')) {
+            return std::nullopt;
+        }
+        uint16_t mask = 0;
+        for (char digit : part.substr(1)) {
+            if (digit < '0' || digit > '8') {
+                return std::nullopt;
+            }
+            mask |= static_cast<uint16_t>(1 << (digit - '0'));
+        }
+        return mask;
+    };
+
+    const size_t separator = text.find('/');
+    if (separator == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto birth = parseCounts(text.substr(0, separator), 'B');
+    const auto survival = parseCounts(text.substr(separator + 1), 'S');
+    if (!birth || !survival) {
+        return std::nullopt;
+    }
+    return Rule{ *birth, *survival };
+}
+
+inline std::string Rule::toString() const {
+    std::string text = "B";
+    for (int count = 0; count <= 8; ++count) {
+        if (birth & (1 << count)) {
+            text += static_cast<char>('0' + count);
+        }
+    }
+    text += "/S";
+    for (int count = 0; count <= 8; ++count) {
+        if (survival & (1 << count)) {
+            text += static_cast<char>('0' + count);
+        }
+    }
+    return text;
+}
+
+} // namespace GameOfLife::Server
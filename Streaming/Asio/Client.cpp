@@ -1,4 +1,5 @@
 #include "Client.h"
+#include "TileLayout.h"
 #include "Log.h"
 
 namespace Streaming::Asio {
@@ -91,6 +92,15 @@ void AsioClient::disconnect() {
             } else {
                 Log::Warning(Print::composeMessage("Warning: Could not parse stored multicast address on disconnect: ", mMulticastAddress));
             }
+
+            std::lock_guard<std::mutex> lock(mTilesMutex);
+            for (int tileIndex : mJoinedTiles) {
+                ip::address tileIp = ip::make_address(TileLayout::getGroupAddress(mMulticastAddress, tileIndex), ec);
+                if (!ec) {
+                    mSocket.set_option(ip::multicast::leave_group(tileIp), ec);
+                }
+            }
+            mJoinedTiles.clear();
             mSocket.close();
         }
         
@@ -129,6 +139,51 @@ bool AsioClient::isConnected() const {
     return mConnected;
 }
 
+bool AsioClient::joinTile(int tileIndex) {
+    return changeTileMembership(tileIndex, true);
+}
+
+bool AsioClient::leaveTile(int tileIndex) {
+    return changeTileMembership(tileIndex, false);
+}
+
+bool AsioClient::changeTileMembership(int tileIndex, bool join) {
+    if (!mConnected || !mSocket.is_open()) {
+        return false;
+    }
+
+    namespace ip = boost::asio::ip;
+    std::lock_guard<std::mutex> lock(mTilesMutex);
+    if (mJoinedTiles.contains(tileIndex) == join) {
+        return true;
+    }
+
+    boost::system::error_code ec;
+    ip::address tileIp = ip::make_address(TileLayout::getGroupAddress(mMulticastAddress, tileIndex), ec);
+    if (ec) {
+        Log::Error(Print::composeMessage("Invalid multicast group for tile ", tileIndex, ": ", ec.message()));
+        return false;
+    }
+
+    if (join) {
+        mSocket.set_option(ip::multicast::join_group(tileIp), ec);
+    } else {
+        mSocket.set_option(ip::multicast::leave_group(tileIp), ec);
+    }
+    if (ec) {
+        Log::Error(Print::composeMessage("Failed to", (join ? "join" : "leave"), "group", tileIp.to_string(), ":", ec.message()));
+        return false;
+    }
+
+    if (join) {
+        mJoinedTiles.insert(tileIndex);
+    } else {
+        mJoinedTiles.erase(tileIndex);
+    }
+    Log::Debug("{} tile {} group {}", (join ? "Joined" : "Left"), tileIndex, tileIp);
+    return true;
+}
+
 void AsioClient::startReceive() {
     if (!mRunning || !mSocket.is_open()) {
         return;
@@ -7,6 +7,8 @@
 #include <atomic>
 #include <vector>
 #include <optional>
+#include <set>
+#include <mutex>
 
 namespace Streaming::Asio {
 
@@ -21,8 +23,11 @@ public:
     void setOnDisconnected(ConnectionCallback callback) override;
     void setOnDataReceived(DataCallback callback) override;
     bool isConnected() const override;
+    bool joinTile(int tileIndex) override;
+    bool leaveTile(int tileIndex) override;
 private:
     void startReceive();
+    bool changeTileMembership(int tileIndex, bool join);
     void handleReceive(const boost::system::error_code& error, std::size_t bytesReceived);
 private:
     using udp = boost::asio::ip::udp;
@@ -32,6 +37,7 @@ private:
     using Socket = udp::socket;
     using AtomicFlag = std::atomic<bool>;
     using Buffer = std::string;
+    using TileSet = std::set<int>;
 private:
     IoContext mIoContext;
     Socket mSocket;
@@ -43,6 +49,8 @@ private:
     AtomicFlag mRunning;
     AtomicFlag mConnected;
     std::string mMulticastAddress;
+    TileSet mJoinedTiles;
+    std::mutex mTilesMutex;
 private:
     ConnectionCallback mOnConnected;
     ConnectionCallback mOnDisconnected;
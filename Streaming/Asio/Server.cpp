@@ -1,4 +1,5 @@
 #include "Server.h"
+#include "TileLayout.h"
 #include <iostream>
 
 namespace Streaming::Asio {
@@ -80,12 +81,35 @@ bool AsioServer::isRunning() const {
 }
 
 void AsioServer::broadcastData(const std::string& data) {
+    sendTo(data, mMulticastEndpoint);
+}
+
+bool AsioServer::supportsTiles() const {
+    return true;
+}
+
+void AsioServer::broadcastTile(int tileIndex, const std::string& data) {
+    auto it = mTileEndpoints.find(tileIndex);
+    if (it == mTileEndpoints.end()) {
+        using namespace boost::asio::ip;
+        boost::system::error_code ec;
+        address tileIp = make_address(TileLayout::getGroupAddress(mMulticastAddress, tileIndex), ec);
+        if (ec) {
+            std::cerr << "Invalid multicast group for tile " << tileIndex << ": " << ec.message() << std::endl;
+            return;
+        }
+        it = mTileEndpoints.emplace(tileIndex, udp::endpoint(tileIp, mMulticastEndpoint.port())).first;
+    }
+    sendTo(data, it->second);
+}
+
+void AsioServer::sendTo(const std::string& data, const boost::asio::ip::udp::endpoint& endpoint) {
     if (!mRunning || !mSocket || !mSocket->is_open()) {
         return;
     }
     
     try {
-        mSocket->send_to(boost::asio::buffer(data), mMulticastEndpoint);
+        mSocket->send_to(boost::asio::buffer(data), endpoint);
     }
     catch (const std::exception& e) {
         std::cerr << "Error broadcasting data: " << e.what() << std::endl;
@@ -100,6 +124,8 @@ void AsioServer::setupMulticast(const std::string& multicastAddress, int port) {
         throw std::runtime_error("Invalid multicast address: " + multicastAddress + " - " + ec.message());
     }
     mMulticastEndpoint = udp::endpoint(multicast_ip, port);
+    mMulticastAddress = multicastAddress;
+    mTileEndpoints.clear();
 
     mSocket = std::make_unique<udp::socket>(mIoContext, mMulticastEndpoint.protocol());
     mSocket->set_option(udp::socket::reuse_address(true));
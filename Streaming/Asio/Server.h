@@ -7,6 +7,8 @@
 #include <mutex>
 #include <vector>
 #include <atomic>
+#include <map>
+#include <string>
 
 namespace Streaming::Asio {
 
@@ -19,8 +21,11 @@ public:
     void stop() override;
     bool isRunning() const override;
     void broadcastData(const std::string& data) override;
+    bool supportsTiles() const override;
+    void broadcastTile(int tileIndex, const std::string& data) override;
 private:
     void setupMulticast(const std::string& multicastAddress, int port);
+    void sendTo(const std::string& data, const boost::asio::ip::udp::endpoint& endpoint);
 private:
     using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
     using WorkGuardOptional = std::optional<WorkGuard>;
@@ -29,10 +34,13 @@ private:
     using MulticastEndpoint = boost::asio::ip::udp::endpoint;
     using SocketPtr = std::unique_ptr<boost::asio::ip::udp::socket>;
     using IoContext = boost::asio::io_context;
+    using TileEndpoints = std::map<int, MulticastEndpoint>;
 private:
     IoContext mIoContext;
     SocketPtr mSocket;
     MulticastEndpoint mMulticastEndpoint;
+    std::string mMulticastAddress;
+    TileEndpoints mTileEndpoints;
     WorkGuardOptional mWork;
     ThreadPool mThreadPool;
     AtomicFlag mRunning;
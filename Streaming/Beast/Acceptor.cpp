@@ -43,7 +43,7 @@ void Acceptor::initAccept() {
                 Log::Debug("New connection accepted");
                 mCallback(mNextSocket);
             } else {
-                Log::Error(Print::composeMessage("Error occured! Error code = ", ec.value(), ". Message: ", ec.message()));
+                Log::Error("Error occured! Error code = {}. Message: {}", ec.value(), ec.message());
             }
 
             if (!mIsStopped) {
@@ -259,7 +259,7 @@ void BeastClient::fail(boost::system::error_code ec, const std::string& what) {
         return;
     }
     
-    Log::Error(Print::composeMessage("Beast WebSocket client error (", what, "): ", ec.message()));
+    Log::Error("Beast WebSocket client error ({}): {}", what, ec.message());
     
     if (mConnected) {
         try {
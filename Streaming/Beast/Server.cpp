@@ -12,6 +12,7 @@ namespace Streaming::Beast {
 
 BeastServer::BeastServer()
     : mRunning(false)
+    , mMetrics(TransportMetrics::create("beast"))
 {
     Log::Debug("BeastServer creating...");
 }
@@ -56,9 +57,9 @@ bool BeastServer::start(const std::string& address, int port, int threadCount) {
         mThreadPool.emplace_back(
             [this, i]() {
                 try {
-                    Log::Debug(Print::composeMessage("BeastServer thread started: ", i, " (ID: ", std::this_thread::get_id(), ")"));
+                    Log::Debug("BeastServer thread started: {} (ID: {})", i, std::this_thread::get_id());
                     mIoContext.run();
-                    Log::Debug(Print::composeMessage("BeastServer thread exiting: ", i, " (ID: ", std::this_thread::get_id(), ")"));
+                    Log::Debug("BeastServer thread exiting: {} (ID: {})", i, std::this_thread::get_id());
                 } catch (const std::exception& e) {
                     Log::Error(Print::composeMessage("BeastServer thread exception: ", e.what()));
                 } catch (...) {
@@ -81,7 +82,6 @@ void BeastServer::stop() {
 
     if (mAcceptor) {
         mAcceptor->stop();
-        mAcceptor.reset();
     }
 
     Log::Debug("Closing active sessions...");
@@ -96,6 +96,7 @@ void BeastServer::stop() {
         }
     }
     mSessions.clear();
+    mMetrics.sessions.set(0);
 
     if (mWork) {
         mWork->reset();
@@ -110,6 +111,8 @@ void BeastServer::stop() {
     }
     mThreadPool.clear();
 
+    // The aborted accept handler still runs on the pool, so the acceptor lives until the join.
+    mAcceptor.reset();
     mIoContext.stop();
 
     Log::Info("BeastServer stopped.");
@@ -140,7 +143,8 @@ void BeastServer::addSession(SessionPtr session) {
     }
     std::lock_guard<std::mutex> lock(mSessionsMutex);
     mSessions.insert(session);
-    Log::Debug(Print::composeMessage("Session added. Total sessions: ", mSessions.size()));
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Session added. Total sessions: {}", mSessions.size());
 }
 
 void BeastServer::removeSession(SessionPtr session) {
@@ -149,7 +153,12 @@ void BeastServer::removeSession(SessionPtr session) {
     }
     std::lock_guard<std::mutex> lock(mSessionsMutex);
     mSessions.erase(session);
-    Log::Debug(Print::composeMessage("Session removed. Total sessions: ", mSessions.size()));
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Session removed. Total sessions: {}", mSessions.size());
+}
+
+TransportMetrics& BeastServer::getMetrics() {
+    return mMetrics;
 }
 
 void BeastServer::onAccept(Acceptor::TcpSocketPtr socketPtr) {
@@ -168,6 +177,7 @@ void BeastServer::onAccept(Acceptor::TcpSocketPtr socketPtr) {
         return;
     }
 
+    mMetrics.accepted.increment();
     Log::Debug("BeastServer::onAccept - Creating session for new connection.");
     auto session = std::make_shared<Session>(*this, std::move(*socketPtr));
     session->run();
@@ -13,6 +13,7 @@
 #include <boost/beast/websocket.hpp>
 
 #include "IServer.h"
+#include "TransportMetrics.h"
 #include "Session.h"
 #include "Acceptor.h"
 
@@ -32,6 +33,7 @@ public:
 public:
     void addSession(SessionPtr session);
     void removeSession(SessionPtr session);
+    TransportMetrics& getMetrics();
 private:
     void onAccept(Acceptor::TcpSocketPtr socketPtr);
 private:
@@ -49,6 +51,7 @@ private:
     AtomicFlag mRunning;
     AcceptorPtr mAcceptor;
     ThreadPool mThreadPool;
+    TransportMetrics mMetrics;
 };
 
 } // namespace Streaming::Beast
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "Log.h"
+#include "Trace.h"
 
 namespace Streaming::Beast {
 
@@ -100,11 +101,14 @@ void Session::send(const std::string& message) {
             }
 
             bool startWriting;
+            size_t queueDepth;
             {
                 std::lock_guard<std::mutex> lock(mQueueMutex);
                 startWriting = mWriteQueue.empty();
                 mWriteQueue.push(std::move(msg));
+                queueDepth = mWriteQueue.size();
             }
+            mServer.getMetrics().queueDepth.observe(static_cast<double>(queueDepth));
 
             if (startWriting) {
                 write();
@@ -114,14 +118,15 @@ void Session::send(const std::string& message) {
 }
 
 void Session::write() {
-    if (mIsClosing || mIsWriting) {
+    TRACE_SCOPE("Beast::Session::write");
+    if (mIsClosing) {
         return;
     }
 
     std::shared_ptr<std::string> messageToSend;
     {
         std::lock_guard<std::mutex> lock(mQueueMutex);
-        if (mWriteQueue.empty()) {
+        if (mWriteQueue.empty() || mIsWriting) {
             return;
         }
         mIsWriting = true;
@@ -146,21 +151,15 @@ void Session::write() {
                     return;
                 }
 
-                bool queueEmpty = true;
                 {
                     std::lock_guard<std::mutex> lock(mQueueMutex);
-                    queueEmpty = mWriteQueue.empty();
-                }
-
-                if (!queueEmpty) {
-                    write();
-                } else {
                     mIsWriting = false;
                 }
+                write();
             }
         );
     } catch (const std::exception& e) {
-        Log::Error(Print::composeMessage("Beast Session Exception in write(): ", e.what()));
+        Log::Error("Beast Session Exception in write(): {}", e.what());
         mIsWriting = false;
         close();
     } catch (...) {
@@ -175,7 +174,7 @@ void Session::fail(beast::error_code ec, const std::string& message) {
         return;
     }
 
-    Log::Error(Print::composeMessage("Beast Session Error (", message, "): ", ec.message()));
+    Log::Error("Beast Session Error ({}): {}", message, ec.message());
 
     close();
 }
@@ -0,0 +1,59 @@
+#include "CompositeServer.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <algorithm>
+
+namespace Streaming {
+
+CompositeServer::~CompositeServer() {
+    stop();
+}
+
+void CompositeServer::addServer(ServerPtr server, const std::string& address, int port) {
+    mEntries.push_back({ std::move(server), address, port });
+}
+
+bool CompositeServer::start(const std::string& address, int port, int threadCount) {
+    for (auto& entry : mEntries) {
+        const auto& entryAddress = entry.address.empty() ? address : entry.address;
+        int entryPort = entry.port > 0 ? entry.port : port;
+        if (!entry.server->start(entryAddress, entryPort, threadCount)) {
+            Log::Error(Print::composeMessage("Failed to start transport on ", entryAddress, ":", entryPort));
+            stop();
+            return false;
+        }
+    }
+    return !mEntries.empty();
+}
+
+void CompositeServer::stop() {
+    for (auto& entry : mEntries) {
+        if (entry.server->isRunning()) {
+            entry.server->stop();
+        }
+    }
+}
+
+void CompositeServer::broadcastData(const std::string& data) {
+    for (auto& entry : mEntries) {
+        entry.server->broadcastData(data);
+    }
+}
+
+bool CompositeServer::isRunning() const {
+    return std::any_of(mEntries.begin(), mEntries.end(), [](const Entry& entry) { return entry.server->isRunning(); });
+}
+
+bool CompositeServer::supportsTiles() const {
+    // Mixing tiled and whole-grid transports would starve the latter, so tile only if all can.
+    return !mEntries.empty() && std::all_of(mEntries.begin(), mEntries.end(), [](const Entry& entry) { return entry.server->supportsTiles(); });
+}
+
+void CompositeServer::broadcastTile(int tileIndex, const std::string& data) {
+    for (auto& entry : mEntries) {
+        entry.server->broadcastTile(tileIndex, data);
+    }
+}
+
+} // namespace Streaming
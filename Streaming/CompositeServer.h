@@ -0,0 +1,35 @@
+#pragma once
+
+#include "IServer.h"
+#include <string>
+#include <vector>
+
+namespace Streaming {
+
+// Fans every frame out to several transports, e.g. WebSocket and multicast at once.
+class CompositeServer : public IServer {
+public:
+    CompositeServer() = default;
+    ~CompositeServer() override;
+public:
+    // An empty address or zero port falls back to the values passed to start().
+    void addServer(ServerPtr server, const std::string& address, int port);
+public:
+    bool start(const std::string& address, int port, int threadCount = 1) override;
+    void stop() override;
+    void broadcastData(const std::string& data) override;
+    bool isRunning() const override;
+    bool supportsTiles() const override;
+    void broadcastTile(int tileIndex, const std::string& data) override;
+private:
+    struct Entry {
+        ServerPtr server;
+        std::string address;
+        int port;
+    };
+    using Entries = std::vector<Entry>;
+private:
+    Entries mEntries;
+};
+
+} // namespace Streaming
@@ -0,0 +1,111 @@
+#include "FrameTrailer.h"
+
+#include <charconv>
+#include <chrono>
+
+namespace Streaming {
+
+namespace {
+    const char FIELD_SEPARATOR = ';';
+    const char VALUE_SEPARATOR = '=';
+    const char FRAME_DELIMITER = '\n';
+    const char GENERATION_KEY = 'g';
+    const char SEQUENCE_KEY = 'n';
+    const char TICK_START_KEY = 'a';
+    const char SIMULATED_KEY = 's';
+    const char SERIALIZED_KEY = 't';
+
+    void appendField(std::string& trailer, char key, uint64_t value) {
+        if (trailer.size() > 1) {
+            trailer += FIELD_SEPARATOR;
+        }
+        trailer += key;
+        trailer += VALUE_SEPARATOR;
+        trailer += std::to_string(value);
+    }
+}
+
+const char FrameTrailer::MARKER = '|';
+
+void FrameTrailer::append(std::string& frame, const Stamp& stamp) {
+    std::string trailer(1, MARKER);
+    appendField(trailer, GENERATION_KEY, stamp.generation);
+    if (stamp.sequence != 0) {
+        appendField(trailer, SEQUENCE_KEY, stamp.sequence);
+    }
+    if (stamp.tickStartNs != 0) {
+        appendField(trailer, TICK_START_KEY, stamp.tickStartNs);
+    }
+    if (stamp.simulatedNs != 0) {
+        appendField(trailer, SIMULATED_KEY, stamp.simulatedNs);
+    }
+    if (stamp.serializedNs != 0) {
+        appendField(trailer, SERIALIZED_KEY, stamp.serializedNs);
+    }
+
+    // The trailer belongs to the frame, so it goes in front of the delimiter.
+    const bool delimited = !frame.empty() && frame.back() == FRAME_DELIMITER;
+    frame.insert(delimited ? frame.size() - 1 : frame.size(), trailer);
+}
+
+std::optional<FrameTrailer::Stamp> FrameTrailer::parse(const std::string& frame, size_t& trailerPosition) {
+    size_t end = frame.size();
+    if (end > 0 && frame[end - 1] == FRAME_DELIMITER) {
+        --end;
+    }
+    trailerPosition = frame.rfind(MARKER, end);
+    if (trailerPosition == std::string::npos) {
+        return std::nullopt;
+    }
+
+    Stamp stamp;
+    bool hasGeneration = false;
+    const char* cursor = frame.data() + trailerPosition + 1;
+    const char* last = frame.data() + end;
+    while (cursor < last) {
+        if (last - cursor < 2 || cursor[1] != VALUE_SEPARATOR) {
+            return std::nullopt;
+        }
+        const char key = cursor[0];
+        uint64_t value = 0;
+        auto result = std::from_chars(cursor + 2, last, value);
+        if (result.ec != std::errc()) {
+            return std::nullopt;
+        }
+        if (key == GENERATION_KEY) {
+            stamp.generation = value;
+            hasGeneration = true;
+        }
+        else if (key == SEQUENCE_KEY) {
+            stamp.sequence = value;
+        }
+        else if (key == TICK_START_KEY) {
+            stamp.tickStartNs = value;
+        }
+        else if (key == SIMULATED_KEY) {
+            stamp.simulatedNs = value;
+        }
+        else if (key == SERIALIZED_KEY) {
+            stamp.serializedNs = value;
+        }
+        // Unknown keys are skipped so newer writers stay readable.
+        cursor = result.ptr;
+        if (cursor < last) {
+            if (*cursor != FIELD_SEPARATOR) {
+                return std::nullopt;
+            }
+            ++cursor;
+        }
+    }
+    if (!hasGeneration) {
+        return std::nullopt;
+    }
+    return stamp;
+}
+
+uint64_t FrameTrailer::now() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace Streaming
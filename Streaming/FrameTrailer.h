@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Streaming {
+
+// Metadata appended after the cells of a grid frame:
+// "|g=<generation>;n=<frame sequence>;a=<tick start>;s=<simulation done>;t=<serialization done>".
+// Readers that only look at the header and cells skip it, readers that care find it
+// by searching back from the end. Timestamps are nanoseconds of the system clock so
+// a client on a host with a synchronized clock can split latency into stages.
+// A zero timestamp means the writer did not record that stage and is left out. The
+// sequence counts frames from 1 without gaps even when one frame advances several
+// generations, so readers check continuity on it; zero means the writer has none.
+class FrameTrailer {
+public:
+    struct Stamp {
+        uint64_t generation = 0;
+        uint64_t sequence = 0;
+        uint64_t tickStartNs = 0;
+        uint64_t simulatedNs = 0;
+        uint64_t serializedNs = 0;
+    };
+public:
+    static void append(std::string& frame, const Stamp& stamp);
+    static std::optional<Stamp> parse(const std::string& frame, size_t& trailerPosition);
+    static uint64_t now();
+public:
+    static const char MARKER;
+};
+
+} // namespace Streaming
@@ -19,6 +19,9 @@ public:
     virtual void setOnDisconnected(ConnectionCallback callback) = 0;
     virtual void setOnDataReceived(DataCallback callback) = 0;
     virtual bool isConnected() const = 0;
+public:
+    virtual bool joinTile(int /*tileIndex*/) { return false; }
+    virtual bool leaveTile(int /*tileIndex*/) { return false; }
 };
 
 using ClientPtr = std::unique_ptr<IClient>;
@@ -16,6 +16,10 @@ public:
     virtual void stop() = 0;
     virtual void broadcastData(const std::string& data) = 0;
     virtual bool isRunning() const = 0;
+public:
+    // Spatial tiling is only meaningful for multicast transports, the rest fall back to a whole-world broadcast.
+    virtual bool supportsTiles() const { return false; }
+    virtual void broadcastTile(int /*tileIndex*/, const std::string& data) { broadcastData(data); }
 };
 
 using ServerPtr = std::unique_ptr<IServer>;
@@ -1,6 +1,8 @@
 #include "Client.h"
 #include "Log.h"
 #include "Print.h"
+#include "TileLayout.h"
+#include "SequenceHeader.h"
 #include <stop_token>
 
 namespace Streaming::Poco {
@@ -14,6 +16,8 @@ PocoClient::PocoClient()
     : mRunning(false)
     , mConnected(false)
     , mReceiveBuffer(MAX_BUFFER_SIZE, ' ')
+    , mLostFrames(0)
+    , mReorderedFrames(0)
 {
     Log::Debug("PocoClient created.");
 }
@@ -48,6 +52,10 @@ bool PocoClient::connect(const std::string& multicastAddress, int port) {
 
         mSocket->joinGroup(mMulticastGroupAddress.host());
 
+        mLastSequences.clear();
+        mLostFrames = 0;
+        mReorderedFrames = 0;
+
         mRunning = true;
         mConnected = true;
 
@@ -103,17 +111,31 @@ void PocoClient::disconnect() {
         mReceiveThread.join();
         Log::Debug("PocoClient receive thread joined.");
     }
+    Log::Info(Print::composeMessage("PocoClient sequence stats. Lost frames: ", mLostFrames, ", reordered frames: ", mReorderedFrames));
 
     try {
         if (mSocket) {
             try {
                 if (mMulticastGroupAddress.host().isMulticast()) {
                     mSocket->leaveGroup(mMulticastGroupAddress.host());
-                    Log::Debug(Print::composeMessage("Left multicast group: ", mMulticastGroupAddress.host().toString()));
+                    Log::Debug("Left multicast group: {}", mMulticastGroupAddress.host().toString());
                 }
             } catch (const ::Poco::Exception& e) {
                  Log::Warning(Print::composeMessage("Exception leaving multicast group: ", e.displayText()));
             }
+
+            std::lock_guard<std::mutex> lock(mTilesMutex);
+            for (int tileIndex : mJoinedTiles) {
+                ::Poco::Net::IPAddress tileIp;
+                if (::Poco::Net::IPAddress::tryParse(TileLayout::getGroupAddress(mMulticastGroupAddress.host().toString(), tileIndex), tileIp)) {
+                    try {
+                        mSocket->leaveGroup(tileIp);
+                    } catch (const ::Poco::Exception& e) {
+                        Log::Warning(Print::composeMessage("Exception leaving tile group: ", e.displayText()));
+                    }
+                }
+            }
+            mJoinedTiles.clear();
             
             if (mSocket->impl() && mSocket->impl()->initialized()) {
                 mSocket->close();
@@ -153,6 +175,48 @@ void PocoClient::setOnDataReceived(std::function<void(const std::string&)> callb
     mOnDataReceived = std::move(callback);
 }
 
+bool PocoClient::joinTile(int tileIndex) {
+    return changeTileMembership(tileIndex, true);
+}
+
+bool PocoClient::leaveTile(int tileIndex) {
+    return changeTileMembership(tileIndex, false);
+}
+
+bool PocoClient::changeTileMembership(int tileIndex, bool join) {
+    if (!mConnected || !mSocket) {
+        return false;
+    }
+
+    namespace PocoNet = ::Poco::Net;
+    std::lock_guard<std::mutex> lock(mTilesMutex);
+    if (mJoinedTiles.contains(tileIndex) == join) {
+        return true;
+    }
+
+    PocoNet::IPAddress tileIp;
+    if (!PocoNet::IPAddress::tryParse(TileLayout::getGroupAddress(mMulticastGroupAddress.host().toString(), tileIndex), tileIp)) {
+        Log::Error(Print::composeMessage("Invalid multicast group for tile ", tileIndex));
+        return false;
+    }
+
+    try {
+        if (join) {
+            mSocket->joinGroup(tileIp);
+            mJoinedTiles.insert(tileIndex);
+        } else {
+            mSocket->leaveGroup(tileIp);
+            mJoinedTiles.erase(tileIndex);
+        }
+    } catch (const ::Poco::Exception& e) {
+        Log::Error(Print::composeMessage("Poco Exception changing tile membership: ", e.displayText()));
+        return false;
+    }
+
+    Log::Debug("{} tile {} group {}", (join ? "Joined" : "Left"), tileIndex, tileIp.toString());
+    return true;
+}
+
 void PocoClient::receiveLoop(std::stop_token stopToken) {
     Log::Debug("PocoClient receive loop started.");
     ::Poco::Timespan timeout(10000);
@@ -210,6 +274,11 @@ void PocoClient::handleReceivedData(int length) {
         std::string completeFrame = mFrameBuffer.substr(0, delimiterPos);
         mFrameBuffer.erase(0, delimiterPos + 1);
 
+        if (!acceptSequence(completeFrame)) {
+            delimiterPos = mFrameBuffer.find(FRAME_DELIMITER);
+            continue;
+        }
+
         if (mOnDataReceived && !completeFrame.empty()) {
             try {
                 mOnDataReceived(completeFrame);
@@ -221,4 +290,32 @@ void PocoClient::handleReceivedData(int length) {
     }
 }
 
+bool PocoClient::acceptSequence(std::string& frame) {
+    int streamId = 0;
+    uint64_t sequence = 0;
+    size_t headerLength = SequenceHeader::parse(frame, streamId, sequence);
+    if (headerLength == 0) {
+        return true;
+    }
+    frame.erase(0, headerLength);
+
+    auto [it, inserted] = mLastSequences.try_emplace(streamId, sequence);
+    if (inserted) {
+        return true;
+    }
+
+    uint64_t& lastSequence = it->second;
+    if (sequence <= lastSequence) {
+        ++mReorderedFrames;
+        Log::Debug("Dropping out of order frame {} on stream {}, last seen {}", sequence, streamId, lastSequence);
+        return false;
+    }
+    if (sequence > lastSequence + 1) {
+        mLostFrames += sequence - lastSequence - 1;
+        Log::Debug("Lost {} frames on stream {}", sequence - lastSequence - 1, streamId);
+    }
+    lastSequence = sequence;
+    return true;
+}
+
 } // namespace Streaming::Poco
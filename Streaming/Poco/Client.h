@@ -10,6 +10,11 @@
 #include <memory>
 #include <thread>
 #include <stop_token>
+#include <set>
+#include <map>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
 
 namespace Streaming::Poco {
 
@@ -24,21 +29,32 @@ public:
     void setOnDisconnected(std::function<void()> callback) override;
     void setOnDataReceived(std::function<void(const std::string&)> callback) override;
     bool isConnected() const override;
+    bool joinTile(int tileIndex) override;
+    bool leaveTile(int tileIndex) override;
 private:
     void receiveLoop(std::stop_token stopToken);
+    bool changeTileMembership(int tileIndex, bool join);
     void handleReceivedData(int length);
+    bool acceptSequence(std::string& frame);
 private:
     using MulticastSocket = ::Poco::Net::MulticastSocket;
     using SocketPtr = std::unique_ptr<MulticastSocket>;
     using SocketAddress = ::Poco::Net::SocketAddress;
     using AtomicFlag = std::atomic<bool>;
+    using TileSet = std::set<int>;
+    using Sequences = std::map<int, uint64_t>;
 private:
     SocketPtr mSocket;
     SocketAddress mMulticastGroupAddress;
+    TileSet mJoinedTiles;
+    std::mutex mTilesMutex;
     SocketAddress mSenderAddress;
 
     std::string mReceiveBuffer;
     std::string mFrameBuffer;
+    Sequences mLastSequences;
+    uint64_t mLostFrames;
+    uint64_t mReorderedFrames;
 
     AtomicFlag mRunning;
     AtomicFlag mConnected;
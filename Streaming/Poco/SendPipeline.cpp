@@ -0,0 +1,110 @@
+#include "SendPipeline.h"
+#include "SequenceHeader.h"
+#include "ThreadPoolManager.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <Poco/Net/NetException.h>
+
+namespace Streaming::Poco {
+
+SendPipeline::SendPipeline(SocketPtr socket, size_t maxPendingFrames)
+    : mSocket(std::move(socket))
+    , mMaxPendingFrames(maxPendingFrames)
+    , mDrainScheduled(false)
+    , mClosed(false)
+    , mDroppedFrames(0)
+    , mMetrics(TransportMetrics::create("poco"))
+{
+    Log::Debug("SendPipeline created.");
+}
+
+SendPipeline::~SendPipeline() {
+    Log::Debug("SendPipeline destroyed. Dropped frames: {}", mDroppedFrames);
+}
+
+void SendPipeline::send(int streamId, const SocketAddress& targetAddress, const std::string& data) {
+    bool scheduleDrain = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed) {
+            return;
+        }
+
+        std::string packet = SequenceHeader::compose(streamId, ++mSequences[streamId]);
+        packet += data;
+
+        // A late frame is worth less than a fresh one: drop the oldest, receivers see the gap.
+        if (mPending.size() >= mMaxPendingFrames) {
+            mPending.pop_front();
+            ++mDroppedFrames;
+            mMetrics.droppedFrames.increment();
+        }
+        mPending.push_back({ targetAddress, std::move(packet) });
+        mMetrics.queueDepth.observe(static_cast<double>(mPending.size()));
+
+        if (!mDrainScheduled) {
+            mDrainScheduled = true;
+            scheduleDrain = true;
+        }
+    }
+
+    if (scheduleDrain && !ThreadPoolManager::Get().enqueue([self = shared_from_this()]() { self->drain(); })) {
+        Log::Warning("SendPipeline could not schedule a drain task, thread pool queue is full.");
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDrainScheduled = false;
+    }
+}
+
+void SendPipeline::close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClosed = true;
+    mPending.clear();
+}
+
+uint64_t SendPipeline::getDroppedFrames() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDroppedFrames;
+}
+
+void SendPipeline::drain() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mPending.empty() || mClosed) {
+                mDrainScheduled = false;
+                return;
+            }
+            std::swap(mBatch, mPending);
+        }
+
+        for (const auto& packet : mBatch) {
+            sendPacket(packet.targetAddress, packet.data);
+        }
+        mBatch.clear();
+    }
+}
+
+void SendPipeline::sendPacket(const SocketAddress& targetAddress, const std::string& packet) {
+    try {
+        if (!mSocket || !mSocket->impl() || !mSocket->impl()->initialized()) {
+            Log::Warning("Broadcast skipped: Socket is closed or invalid.");
+            return;
+        }
+
+        int bytesSent = mSocket->sendTo(packet.data(), static_cast<int>(packet.length()), targetAddress);
+        if (bytesSent != static_cast<int>(packet.length())) {
+            Log::Warning(Print::composeMessage("Could not send complete UDP packet. Expected: ", packet.length(), ", Sent: ", bytesSent));
+        }
+    } catch (const ::Poco::Net::NetException& e) {
+        if (e.code() != POCO_ENETRESET && e.code() != POCO_ESHUTDOWN && e.code() != POCO_ECONNABORTED) {
+            Log::Error(Print::composeMessage("Poco NetException during broadcast: ", e.displayText()));
+        }
+    } catch (const ::Poco::Exception& e) {
+        Log::Error(Print::composeMessage("Poco Exception during broadcast: ", e.displayText()));
+    } catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Standard exception during broadcast: ", e.what()));
+    }
+}
+
+} // namespace Streaming::Poco
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Poco/Net/MulticastSocket.h>
+#include <Poco/Net/SocketAddress.h>
+
+#include "TransportMetrics.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <deque>
+
+namespace Streaming::Poco {
+
+// Serial send queue for one socket. Frames are stamped with a per-stream sequence
+// number and written in generation order; the queue is drained in batches by a
+// single task on the shared thread pool, so sendTo is never called concurrently.
+class SendPipeline : public std::enable_shared_from_this<SendPipeline> {
+public:
+    using MulticastSocket = ::Poco::Net::MulticastSocket;
+    using SocketPtr = std::shared_ptr<MulticastSocket>;
+    using SocketAddress = ::Poco::Net::SocketAddress;
+public:
+    SendPipeline(SocketPtr socket, size_t maxPendingFrames = 256);
+    ~SendPipeline();
+public:
+    void send(int streamId, const SocketAddress& targetAddress, const std::string& data);
+    void close();
+    uint64_t getDroppedFrames() const;
+private:
+    void drain();
+    void sendPacket(const SocketAddress& targetAddress, const std::string& packet);
+private:
+    struct Packet {
+        SocketAddress targetAddress;
+        std::string data;
+    };
+    using Packets = std::deque<Packet>;
+    using Sequences = std::map<int, uint64_t>;
+private:
+    SocketPtr mSocket;
+    size_t mMaxPendingFrames;
+    Packets mPending;
+    Packets mBatch;
+    Sequences mSequences;
+    bool mDrainScheduled;
+    bool mClosed;
+    uint64_t mDroppedFrames;
+    TransportMetrics mMetrics;
+    mutable std::mutex mMutex;
+};
+
+using SendPipelinePtr = std::shared_ptr<SendPipeline>;
+
+} // namespace Streaming::Poco
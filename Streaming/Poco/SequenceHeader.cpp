@@ -0,0 +1,45 @@
+#include "SequenceHeader.h"
+
+#include <charconv>
+
+namespace Streaming::Poco {
+
+namespace {
+    const char SEQUENCE_MARKER = 'S';
+    const char STREAM_SEPARATOR = ':';
+    const char HEADER_TERMINATOR = '|';
+    const size_t MAX_HEADER_LENGTH = 32;
+}
+
+std::string SequenceHeader::compose(int streamId, uint64_t sequence) {
+    std::string header;
+    header.reserve(MAX_HEADER_LENGTH);
+    header += SEQUENCE_MARKER;
+    header += std::to_string(streamId);
+    header += STREAM_SEPARATOR;
+    header += std::to_string(sequence);
+    header += HEADER_TERMINATOR;
+    return header;
+}
+
+size_t SequenceHeader::parse(const std::string& frame, int& streamId, uint64_t& sequence) {
+    if (frame.empty() || frame[0] != SEQUENCE_MARKER) {
+        return 0;
+    }
+    size_t terminator = frame.find(HEADER_TERMINATOR);
+    size_t separator = frame.find(STREAM_SEPARATOR);
+    if (terminator == std::string::npos || terminator > MAX_HEADER_LENGTH || separator == std::string::npos || separator > terminator) {
+        return 0;
+    }
+
+    const char* begin = frame.data();
+    auto streamResult = std::from_chars(begin + 1, begin + separator, streamId);
+    auto sequenceResult = std::from_chars(begin + separator + 1, begin + terminator, sequence);
+    if (streamResult.ec != std::errc() || streamResult.ptr != begin + separator
+        || sequenceResult.ec != std::errc() || sequenceResult.ptr != begin + terminator) {
+        return 0;
+    }
+    return terminator + 1;
+}
+
+} // namespace Streaming::Poco
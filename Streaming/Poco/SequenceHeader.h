@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Streaming::Poco {
+
+// Prefix put in front of every multicast frame so receivers can spot lost and
+// reordered datagrams. Each stream (whole grid or a single tile) counts separately.
+class SequenceHeader {
+public:
+    static std::string compose(int streamId, uint64_t sequence);
+    static size_t parse(const std::string& frame, int& streamId, uint64_t& sequence);
+};
+
+} // namespace Streaming::Poco
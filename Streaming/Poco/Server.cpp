@@ -2,6 +2,7 @@
 #include "Log.h"
 #include "Print.h"
 #include "ThreadPoolManager.h"
+#include "TileLayout.h"
 
 #include <Poco/Net/NetException.h>
 
@@ -10,7 +11,6 @@ namespace Streaming::Poco {
 PocoServer::PocoServer()
     : mRunning(false)
 {
-    ThreadPoolManager::Init();
     Log::Debug("PocoServer created.");
 }
 
@@ -36,12 +36,14 @@ bool PocoServer::start(const std::string& multicastAddress, int port, int thread
             return false;
         }
         mMulticastAddress = PocoNet::SocketAddress(ipAddr, port);
+        mTileAddresses.clear();
         mSocket = std::make_shared<PocoNet::MulticastSocket>(PocoNet::SocketAddress::IPv4);
         mSocket->setReuseAddress(true);
         // mSocket->setLoopback(false);
         // mSocket->setTimeToLive(1);
 
-        ThreadPoolManager::Get().start(1, threadCount > 0 ? threadCount : 4);
+        ThreadPoolManager::Acquire(threadCount > 0 ? threadCount : 4);
+        mSendPipeline = std::make_shared<SendPipeline>(mSocket);
 
         mRunning = true;
         Log::Info(Print::composeMessage("PocoServer started successfully. Multicast target: ", mMulticastAddress.toString()));
@@ -69,7 +71,11 @@ void PocoServer::stop() {
     Log::Info("Stopping PocoServer...");
     mRunning = 0;
 
-    ThreadPoolManager::Destroy();
+    if (mSendPipeline) {
+        mSendPipeline->close();
+    }
+    ThreadPoolManager::Release();
+    mSendPipeline.reset();
 
     try {
         if (mSocket) {
@@ -90,31 +96,33 @@ bool PocoServer::isRunning() const {
 }
 
 void PocoServer::broadcastData(const std::string& data) {
-    if (!mRunning || !mSocket) {
+    if (!mRunning || !mSendPipeline) {
+        return;
+    }
+    mSendPipeline->send(0, mMulticastAddress, data);
+}
+
+bool PocoServer::supportsTiles() const {
+    return true;
+}
+
+void PocoServer::broadcastTile(int tileIndex, const std::string& data) {
+    if (!mRunning || !mSendPipeline) {
         return;
     }
 
-    ThreadPoolManager::Get().enqueue([socket = mSocket, targetAddress = mMulticastAddress, dataCopy = data]() {
-        try {
-            if (!socket || !socket->impl() || !socket->impl()->initialized()) {
-                 Log::Warning("Broadcast task skipped: Socket is closed or invalid.");
-                 return;
-            }
-
-            int bytesSent = socket->sendTo(dataCopy.data(), static_cast<int>(dataCopy.length()), targetAddress);
-            if (bytesSent != static_cast<int>(dataCopy.length())) {
-                Log::Warning(Print::composeMessage("Could not send complete UDP packet async. Expected: ", dataCopy.length(), ", Sent: ", bytesSent));
-            }
-        } catch (const ::Poco::Net::NetException& e) {
-            if (e.code() != POCO_ENETRESET && e.code() != POCO_ESHUTDOWN && e.code() != POCO_ECONNABORTED) {
-                Log::Error(Print::composeMessage("Poco NetException during async broadcast: ", e.displayText()));
-            }
-        } catch (const ::Poco::Exception& e) {
-            Log::Error(Print::composeMessage("Poco Exception during async broadcast: ", e.displayText()));
-        } catch (const std::exception& e) {
-            Log::Error(Print::composeMessage("Standard exception during async broadcast: ", e.what()));
+    auto it = mTileAddresses.find(tileIndex);
+    if (it == mTileAddresses.end()) {
+        namespace PocoNet = ::Poco::Net;
+        PocoNet::IPAddress tileIp;
+        if (!PocoNet::IPAddress::tryParse(TileLayout::getGroupAddress(mMulticastAddress.host().toString(), tileIndex), tileIp)) {
+            Log::Error(Print::composeMessage("Invalid multicast group for tile ", tileIndex));
+            return;
         }
-    });
+        it = mTileAddresses.emplace(tileIndex, PocoNet::SocketAddress(tileIp, mMulticastAddress.port())).first;
+    }
+    // Stream 0 is the whole grid, tiles follow the same offset as their multicast groups.
+    mSendPipeline->send(tileIndex + 1, it->second, data);
 }
 
 } // namespace Streaming::Poco
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "IServer.h"
+#include "SendPipeline.h"
 #include <Poco/Net/MulticastSocket.h>
 #include <Poco/Net/SocketAddress.h>
 #include <string>
 #include <memory>
+#include <map>
+#include <atomic>
 
 namespace Streaming::Poco {
 
@@ -17,14 +20,19 @@ public:
     void stop() override;
     bool isRunning() const override;
     void broadcastData(const std::string& data) override;
+    bool supportsTiles() const override;
+    void broadcastTile(int tileIndex, const std::string& data) override;
 private:
     using MulticastSocket = ::Poco::Net::MulticastSocket;
     using SocketPtr = std::shared_ptr<MulticastSocket>;
     using SocketAddress = ::Poco::Net::SocketAddress;
     using AtomicFlag = std::atomic<bool>;
+    using TileAddresses = std::map<int, SocketAddress>;
 private:
     SocketPtr mSocket; 
+    SendPipelinePtr mSendPipeline;
     SocketAddress mMulticastAddress;
+    TileAddresses mTileAddresses;
     AtomicFlag mRunning;
 };
 
@@ -1,13 +1,89 @@
 #include "ThreadPoolManager.h"
 #include "Log.h"
+#include "Metrics.h"
 #include "Print.h"
 
+#include <algorithm>
+#include <bit>
 #include <stop_token>
 
 namespace Streaming::Poco {
 
+namespace {
+    struct PoolMetrics {
+        Metrics::Gauge& queueDepth;
+        Metrics::Gauge& maxQueueDepth;
+        Metrics::Counter& completed;
+        Metrics::Counter& rejected;
+        Metrics::Histogram& latency;
+    };
+
+    PoolMetrics& getMetrics() {
+        static PoolMetrics metrics = []() {
+            auto& registry = Metrics::Registry::Get();
+            return PoolMetrics{
+                registry.getGauge("gameoflife_poco_pool_queue_depth", "Tasks waiting in the Poco thread pool queue"),
+                registry.getGauge("gameoflife_poco_pool_max_queue_depth", "Deepest the Poco thread pool queue has been since the pool started"),
+                registry.getCounter("gameoflife_poco_pool_tasks_total", "Tasks run by the Poco thread pool"),
+                registry.getCounter("gameoflife_poco_pool_rejected_total", "Tasks rejected because the Poco thread pool queue was full"),
+                registry.getHistogram("gameoflife_poco_pool_task_latency_seconds", "Time from enqueueing a task to the end of its run",
+                    Metrics::Histogram::exponentialBounds(0.00001, 2, 16))
+            };
+        }();
+        return metrics;
+    }
+}
+
+Task::Task(Task&& other) noexcept {
+    if (other.mInvoke) {
+        other.mRelocate(mStorage, other.mStorage);
+        mInvoke = std::exchange(other.mInvoke, nullptr);
+        mRelocate = std::exchange(other.mRelocate, nullptr);
+        mDestroy = std::exchange(other.mDestroy, nullptr);
+    }
+}
+
+Task& Task::operator=(Task&& other) noexcept {
+    if (this != &other) {
+        reset();
+        if (other.mInvoke) {
+            other.mRelocate(mStorage, other.mStorage);
+            mInvoke = std::exchange(other.mInvoke, nullptr);
+            mRelocate = std::exchange(other.mRelocate, nullptr);
+            mDestroy = std::exchange(other.mDestroy, nullptr);
+        }
+    }
+    return *this;
+}
+
+Task::~Task() {
+    reset();
+}
+
+Task::operator bool() const {
+    return mInvoke != nullptr;
+}
+
+void Task::operator()() {
+    mInvoke(mStorage);
+}
+
+void Task::reset() {
+    if (mDestroy) {
+        mDestroy(mStorage);
+    }
+    mInvoke = nullptr;
+    mRelocate = nullptr;
+    mDestroy = nullptr;
+}
+
 ThreadPoolManager::ThreadPoolManager()
-    : mQueueNotEmpty(false)
+    : mCapacity(0)
+    , mMask(0)
+    , mEnqueuePosition(0)
+    , mDequeuePosition(0)
+    , mWakeups(0)
+    , mMaxQueueDepth(0)
 {
 }
 
@@ -16,148 +92,177 @@ ThreadPoolManager::~ThreadPoolManager() {
     stop();
 }
 
-void ThreadPoolManager::start(unsigned int minThreads, unsigned int maxThreads) {
-    stop();
-    
-    mThreadPool = std::make_unique<ThreadPoolPoco>(minThreads, maxThreads);
-    
-    mQueueNotEmpty = false;
-    startQueueMonitor();
+void ThreadPoolManager::Acquire(unsigned int threadCount) {
+    std::lock_guard<std::mutex> lock(mUsersMutex);
+    if (mUsers++ == 0) {
+        Init();
+        Get().start(threadCount);
+    }
 }
 
-void ThreadPoolManager::stop() {
-    stopQueueMonitor();
-    
-    if (mThreadPool) {
-        Log::Debug("Stopping Poco thread pool");
-        {
-            Log::Debug(Print::composeMessage(mTaskQueue.size(), " tasks in the queue before stopping"));
-            std::lock_guard<std::mutex> lock(mQueueMutex);
-            TaskQueue empty;
-            std::swap(mTaskQueue, empty);
-            mQueueNotEmpty = false;
-        }
-        mThreadPool->joinAll();
-        Log::Debug("Poco thread pool stopped successfully");
-        mThreadPool->stopAll();
-        mThreadPool.reset();
+void ThreadPoolManager::Release() {
+    std::lock_guard<std::mutex> lock(mUsersMutex);
+    if (mUsers > 0 && --mUsers == 0) {
+        Destroy();
     }
 }
 
-void ThreadPoolManager::processNextTask() {
-    RunnableTaskPtr task;
-    {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        if (mTaskQueue.empty()) {
-            return;
-        }
-        task = mTaskQueue.front();
+void ThreadPoolManager::start(unsigned int threadCount, size_t queueCapacity) {
+    stop();
+
+    mCapacity = std::bit_ceil(std::max<size_t>(queueCapacity, 2));
+    mMask = mCapacity - 1;
+    mSlots = std::make_unique<Slot[]>(mCapacity);
+    for (size_t i = 0; i < mCapacity; ++i) {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
     }
-    
-    bool taskStarted = false;
-    try {
-        if (mThreadPool) {
-            mThreadPool->start(*task);
-            taskStarted = true;
-        }
+    mEnqueuePosition = 0;
+    mDequeuePosition = 0;
+    mMaxQueueDepth = 0;
+    getMetrics().queueDepth.set(0);
+    getMetrics().maxQueueDepth.set(0);
+
+    threadCount = std::max(threadCount, 1u);
+    mWorkers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        mWorkers.emplace_back([this](std::stop_token stopToken) {
+            workerLoop(stopToken);
+        });
     }
-    catch (const ::Poco::NoThreadAvailableException&) {
-        std::this_thread::yield();
+    Log::Debug("Poco thread pool started with {} workers and queue capacity {}", threadCount, mCapacity);
+}
+
+void ThreadPoolManager::stop() {
+    if (mWorkers.empty()) {
+        return;
     }
-    
-    if (taskStarted) {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        if (!mTaskQueue.empty() && mTaskQueue.front() == task) {
-            mTaskQueue.pop();
-        }
+
+    Log::Debug("Stopping Poco thread pool");
+    for (auto& worker : mWorkers) {
+        worker.request_stop();
     }
+    mWakeups.fetch_add(1, std::memory_order_release);
+    mWakeups.notify_all();
+    mWorkers.clear();
+
+    Log::Debug("{} tasks in the queue before stopping, at most {} were waiting", getQueueDepth(), mMaxQueueDepth.load(std::memory_order_relaxed));
+
+    mSlots.reset();
+    mCapacity = 0;
+    mMask = 0;
+    Log::Debug("Poco thread pool stopped successfully");
 }
 
-void ThreadPoolManager::startQueueMonitor() {
-    if (mQueueMonitorThread.joinable()) {
-        return;
+bool ThreadPoolManager::enqueue(Task&& task) {
+    if (!mSlots) {
+        return false;
     }
-    
-    mQueueMonitorThread = std::jthread([this](std::stop_token stopToken) {       
-        while (!stopToken.stop_requested()) {
-            mQueueNotEmpty.wait(false);
-            
-            if (stopToken.stop_requested()) {
+
+    // Bounded MPMC queue: every slot carries a sequence number telling producers and
+    // consumers whose turn it is, so neither side takes a lock.
+    size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &mSlots[position & mMask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
                 break;
             }
-            
-            processNextTask();
-            
-            {
-                std::lock_guard<std::mutex> lock(mQueueMutex);
-                mQueueNotEmpty = !mTaskQueue.empty();
-            }
         }
-        
-        Log::Debug("Queue monitor thread stopped");
-    });
-}
-
-void ThreadPoolManager::stopQueueMonitor() {
-    if (!mQueueMonitorThread.joinable()) {
-        return;
+        else if (difference < 0) {
+            getMetrics().rejected.increment();
+            return false;
+        }
+        else {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
     }
-    
-    mQueueMonitorThread.request_stop();
-    
-    mQueueNotEmpty = true;
-    mQueueNotEmpty.notify_one();
-    
-    if (mQueueMonitorThread.joinable()) {
-        mQueueMonitorThread.join();
+
+    slot->task = std::move(task);
+    slot->enqueuedAt = Clock::now();
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    size_t depth = getQueueDepth();
+    getMetrics().queueDepth.set(static_cast<int64_t>(depth));
+    size_t maxDepth = mMaxQueueDepth.load(std::memory_order_relaxed);
+    while (depth > maxDepth) {
+        if (mMaxQueueDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {
+            getMetrics().maxQueueDepth.set(static_cast<int64_t>(depth));
+            break;
+        }
     }
+
+    mWakeups.fetch_add(1, std::memory_order_release);
+    mWakeups.notify_one();
+    return true;
 }
 
-void ThreadPoolManager::enqueue(Task&& task) {
-    if (!mThreadPool) {
-        return;
+bool ThreadPoolManager::tryDequeue(Task& task, Clock::time_point& enqueuedAt) {
+    size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &mSlots[position & mMask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+        if (difference == 0) {
+            if (mDequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = mDequeuePosition.load(std::memory_order_relaxed);
+        }
     }
 
-    auto runnableTask = std::make_shared<RunnableTask>(std::move(task), *this);
-    
-    {
-        std::lock_guard<std::mutex> lock(mActiveTasksMutex);
-        mActiveTasks.insert(runnableTask);
-    }
-    
-    {
-        std::lock_guard<std::mutex> lock(mQueueMutex);
-        mTaskQueue.push(runnableTask);
-        mQueueNotEmpty = true;
-        mQueueNotEmpty.notify_one();
-    }
+    task = std::move(slot->task);
+    enqueuedAt = slot->enqueuedAt;
+    slot->sequence.store(position + mMask + 1, std::memory_order_release);
+    getMetrics().queueDepth.set(static_cast<int64_t>(getQueueDepth()));
+    return true;
 }
 
-void ThreadPoolManager::removeActiveTask(const std::shared_ptr<RunnableTask>& task) {
-    std::lock_guard<std::mutex> lock(mActiveTasksMutex);
-    mActiveTasks.erase(task);
+void ThreadPoolManager::workerLoop(std::stop_token stopToken) {
+    Task task;
+    Clock::time_point enqueuedAt;
+    while (true) {
+        // Snapshot the wakeup counter before checking for work, a task pushed in
+        // between bumps it and wait() returns immediately.
+        uint32_t wakeups = mWakeups.load(std::memory_order_acquire);
+        if (stopToken.stop_requested()) {
+            break;
+        }
+        if (!tryDequeue(task, enqueuedAt)) {
+            mWakeups.wait(wakeups, std::memory_order_acquire);
+            continue;
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            Log::Error(Print::composeMessage("Exception in task execution: ", e.what()));
+        } catch (...) {
+            Log::Error("Unknown exception in task execution");
+        }
+        task = Task();
+        recordCompletion(enqueuedAt);
+    }
 }
 
-RunnableTask::RunnableTask(Task task, ThreadPoolManager& manager) 
-    : mTask(std::move(task))
-    , mManager(manager)
-{
+void ThreadPoolManager::recordCompletion(Clock::time_point enqueuedAt) {
+    auto& metrics = getMetrics();
+    metrics.completed.increment();
+    metrics.latency.observe(std::chrono::duration<double>(Clock::now() - enqueuedAt).count());
 }
 
-void RunnableTask::run() 
-{
-    try {
-        if (mTask) {
-            mTask();
-        }
-    } catch (const std::exception& e) {
-        Log::Error(Print::composeMessage("Exception in task execution: ", e.what()));
-    } catch (...) {
-        Log::Error("Unknown exception in task execution");
-    }
-    
-    auto selfPtr = shared_from_this();
-    mManager.removeActiveTask(selfPtr);
+size_t ThreadPoolManager::getQueueDepth() const {
+    size_t enqueuePosition = mEnqueuePosition.load(std::memory_order_relaxed);
+    size_t dequeuePosition = mDequeuePosition.load(std::memory_order_relaxed);
+    return enqueuePosition >= dequeuePosition ? enqueuePosition - dequeuePosition : 0;
 }
 
-} // namespace Streaming::Poco
\ No newline at end of file
+} // namespace Streaming::Poco
@@ -1,64 +1,113 @@
 #pragma once
 
 #include "Singleton.h"
-#include <Poco/ThreadPool.h>
-#include <Poco/Runnable.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <functional>
-#include <queue>
 #include <mutex>
+#include <new>
+#include <stop_token>
 #include <thread>
-#include <atomic>
-#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Streaming::Poco {
 
-using Task = std::function<void()>;
-
-class ThreadPoolManager;
-
-class RunnableTask : public ::Poco::Runnable, public std::enable_shared_from_this<RunnableTask> {
+// Type-erased callable with in-place storage, so queueing a task never allocates.
+class Task {
 public:
-    explicit RunnableTask(Task task, ThreadPoolManager& manager);
-    void run() override;
-    
+    static constexpr size_t CAPACITY = 128;
+public:
+    Task() = default;
+    template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Task>>>
+    Task(Callable&& callable);
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task();
+public:
+    explicit operator bool() const;
+    void operator()();
+private:
+    void reset();
+private:
+    using Invoke = void (*)(void*);
+    using Relocate = void (*)(void* destination, void* source);
+    using Destroy = void (*)(void*);
 private:
-    Task mTask;
-    ThreadPoolManager& mManager;
+    alignas(std::max_align_t) std::byte mStorage[CAPACITY];
+    Invoke mInvoke = nullptr;
+    Relocate mRelocate = nullptr;
+    Destroy mDestroy = nullptr;
 };
 
 class ThreadPoolManager : public Singleton<ThreadPoolManager>
 {
     friend class Singleton<ThreadPoolManager>;
-    friend class RunnableTask;
 public:
-    void start(unsigned int minThreads = 1, unsigned int maxThreads = 4);
+    // Several Poco transports can run side by side, the pool lives while any of them uses it.
+    static void Acquire(unsigned int threadCount);
+    static void Release();
+public:
+    void start(unsigned int threadCount = 1, size_t queueCapacity = 1024);
     void stop();
     ~ThreadPoolManager();
 public:
-    void enqueue(Task&& task);
+    bool enqueue(Task&& task);
 private:
     ThreadPoolManager();
-private:    
-    void processNextTask();
-    void startQueueMonitor();
-    void stopQueueMonitor();
-    void removeActiveTask(const std::shared_ptr<RunnableTask>& task);
-private:    
-    using ThreadPoolPoco = ::Poco::ThreadPool;
-    using ThreadPoolPtr = std::unique_ptr<ThreadPoolPoco>;
-    using RunnableTaskPtr = std::shared_ptr<RunnableTask>;
-    using TaskQueue = std::queue<RunnableTaskPtr>;
-    using AtomicFlag = std::atomic<bool>;
-    using ActiveTasksStorage = std::set<RunnableTaskPtr>;
 private:
-    ThreadPoolPtr mThreadPool;
-    TaskQueue mTaskQueue;
-    std::mutex mQueueMutex;
-    ActiveTasksStorage mActiveTasks;
-    std::mutex mActiveTasksMutex;
-    AtomicFlag mQueueNotEmpty;
-    std::jthread mQueueMonitorThread;
+    bool tryDequeue(Task& task, std::chrono::steady_clock::time_point& enqueuedAt);
+    void workerLoop(std::stop_token stopToken);
+    void recordCompletion(std::chrono::steady_clock::time_point enqueuedAt);
+    size_t getQueueDepth() const;
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Task task;
+        Clock::time_point enqueuedAt;
+    };
+    using Slots = std::unique_ptr<Slot[]>;
+    using Workers = std::vector<std::jthread>;
+    using AtomicSize = std::atomic<size_t>;
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+private:
+    inline static std::mutex mUsersMutex;
+    inline static unsigned int mUsers = 0;
+private:
+    Slots mSlots;
+    size_t mCapacity;
+    size_t mMask;
+    alignas(CACHE_LINE_SIZE) AtomicSize mEnqueuePosition;
+    alignas(CACHE_LINE_SIZE) AtomicSize mDequeuePosition;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> mWakeups;
+    Workers mWorkers;
+    AtomicSize mMaxQueueDepth;
 };
 
-} // namespace Streaming::Poco
\ No newline at end of file
+template <typename Callable, typename>
+Task::Task(Callable&& callable) {
+    using Stored = std::decay_t<Callable>;
+    static_assert(sizeof(Stored) <= CAPACITY, "Task callable does not fit the in-place storage");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t), "Task callable is over-aligned");
+
+    new (mStorage) Stored(std::forward<Callable>(callable));
+    mInvoke = [](void* storage) {
+        (*static_cast<Stored*>(storage))();
+    };
+    mRelocate = [](void* destination, void* source) {
+        new (destination) Stored(std::move(*static_cast<Stored*>(source)));
+        static_cast<Stored*>(source)->~Stored();
+    };
+    mDestroy = [](void* storage) {
+        static_cast<Stored*>(storage)->~Stored();
+    };
+}
+
+} // namespace Streaming::Poco
@@ -0,0 +1,176 @@
+#include "WebSocketClient.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <Poco/Buffer.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Timespan.h>
+
+namespace Streaming::Poco {
+
+namespace {
+    const char FRAME_DELIMITER = '\n';
+    const ::Poco::Timespan RECEIVE_TIMEOUT(0, 200000);
+}
+
+PocoWebSocketClient::PocoWebSocketClient()
+    : mRunning(false)
+    , mConnected(false)
+{
+    Log::Debug("PocoWebSocketClient created.");
+}
+
+PocoWebSocketClient::~PocoWebSocketClient() {
+    Log::Debug("PocoWebSocketClient destroying...");
+    disconnect();
+}
+
+bool PocoWebSocketClient::connect(const std::string& serverAddress, int port) {
+    if (mConnected || mRunning) {
+        Log::Warning("PocoWebSocketClient is already connected, disconnect first.");
+        return false;
+    }
+
+    Log::Info(Print::composeMessage("Attempting to connect to Poco WebSocket server at ", serverAddress, ":", port));
+
+    namespace PocoNet = ::Poco::Net;
+    try {
+        mSession = std::make_unique<HTTPClientSession>(serverAddress, static_cast<::Poco::UInt16>(port));
+        PocoNet::HTTPRequest request(PocoNet::HTTPRequest::HTTP_GET, "/", PocoNet::HTTPMessage::HTTP_1_1);
+        request.set("User-Agent", "Poco.WebSocket.Client");
+        PocoNet::HTTPResponse response;
+
+        mWebSocket = std::make_unique<WebSocket>(*mSession, request, response);
+        mWebSocket->setReceiveTimeout(RECEIVE_TIMEOUT);
+
+        mFrameBuffer.clear();
+        mRunning = true;
+        mConnected = true;
+        mReceiveThread = std::jthread([this](std::stop_token stopToken) {
+            receiveLoop(stopToken);
+        });
+
+        Log::Info(Print::composeMessage("Connected to Poco WebSocket server at ", serverAddress, ":", port));
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mOnConnected) {
+            mOnConnected();
+        }
+        return true;
+    } catch (const ::Poco::Exception& e) {
+        Log::Error(Print::composeMessage("Poco Exception during WebSocket connect: ", e.displayText()));
+    } catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Standard exception during WebSocket connect: ", e.what()));
+    }
+
+    mWebSocket.reset();
+    mSession.reset();
+    mConnected = false;
+    mRunning = false;
+    return false;
+}
+
+void PocoWebSocketClient::disconnect() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    Log::Info("Disconnecting from Poco WebSocket server...");
+
+    if (mReceiveThread.joinable()) {
+        mReceiveThread.request_stop();
+        mReceiveThread.join();
+    }
+
+    if (mWebSocket) {
+        try {
+            mWebSocket->shutdown();
+            mWebSocket->close();
+        } catch (const ::Poco::Exception& e) {
+            Log::Warning(Print::composeMessage("Exception closing WebSocket: ", e.displayText()));
+        }
+        mWebSocket.reset();
+    }
+    mSession.reset();
+
+    notifyDisconnected();
+    Log::Info("Disconnected from Poco WebSocket server.");
+}
+
+bool PocoWebSocketClient::isConnected() const {
+    return mConnected;
+}
+
+void PocoWebSocketClient::setOnConnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnConnected = std::move(callback);
+}
+
+void PocoWebSocketClient::setOnDisconnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDisconnected = std::move(callback);
+}
+
+void PocoWebSocketClient::setOnDataReceived(DataCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDataReceived = std::move(callback);
+}
+
+void PocoWebSocketClient::receiveLoop(std::stop_token stopToken) {
+    namespace PocoNet = ::Poco::Net;
+    Log::Debug("PocoWebSocketClient receive loop started.");
+
+    ::Poco::Buffer<char> buffer(0);
+    while (!stopToken.stop_requested() && mRunning) {
+        try {
+            int flags = 0;
+            buffer.resize(0);
+            int bytesReceived = mWebSocket->receiveFrame(buffer, flags);
+            if ((bytesReceived == 0 && flags == 0)
+                || (flags & PocoNet::WebSocket::FRAME_OP_BITMASK) == PocoNet::WebSocket::FRAME_OP_CLOSE) {
+                Log::Info("Poco WebSocket server closed the connection.");
+                break;
+            }
+            handleReceivedData(buffer.begin(), bytesReceived);
+        } catch (const ::Poco::TimeoutException&) {
+            continue;
+        } catch (const ::Poco::Exception& e) {
+            if (mRunning) {
+                Log::Error(Print::composeMessage("Poco WebSocket client read error: ", e.displayText()));
+            }
+            break;
+        }
+    }
+
+    notifyDisconnected();
+    Log::Debug("PocoWebSocketClient receive loop finished.");
+}
+
+void PocoWebSocketClient::handleReceivedData(const char* data, int length) {
+    mFrameBuffer.append(data, length);
+
+    size_t delimiterPos = mFrameBuffer.find(FRAME_DELIMITER);
+    while (delimiterPos != std::string::npos) {
+        std::string completeFrame = mFrameBuffer.substr(0, delimiterPos);
+        mFrameBuffer.erase(0, delimiterPos + 1);
+        if (!completeFrame.empty()) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mOnDataReceived) {
+                mOnDataReceived(completeFrame);
+            }
+        }
+        delimiterPos = mFrameBuffer.find(FRAME_DELIMITER);
+    }
+}
+
+void PocoWebSocketClient::notifyDisconnected() {
+    if (mConnected.exchange(false)) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mOnDisconnected) {
+            mOnDisconnected();
+        }
+    }
+}
+
+} // namespace Streaming::Poco
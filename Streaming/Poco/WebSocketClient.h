@@ -0,0 +1,51 @@
+#pragma once
+
+#include "IClient.h"
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/WebSocket.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+namespace Streaming::Poco {
+
+class PocoWebSocketClient : public IClient {
+public:
+    PocoWebSocketClient();
+    ~PocoWebSocketClient() override;
+public:
+    bool connect(const std::string& serverAddress, int port) override;
+    void disconnect() override;
+    bool isConnected() const override;
+    void setOnConnected(ConnectionCallback callback) override;
+    void setOnDisconnected(ConnectionCallback callback) override;
+    void setOnDataReceived(DataCallback callback) override;
+private:
+    void receiveLoop(std::stop_token stopToken);
+    void handleReceivedData(const char* data, int length);
+    void notifyDisconnected();
+private:
+    using HTTPClientSession = ::Poco::Net::HTTPClientSession;
+    using HTTPClientSessionPtr = std::unique_ptr<HTTPClientSession>;
+    using WebSocket = ::Poco::Net::WebSocket;
+    using WebSocketPtr = std::unique_ptr<WebSocket>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    HTTPClientSessionPtr mSession;
+    WebSocketPtr mWebSocket;
+    std::string mFrameBuffer;
+    AtomicFlag mRunning;
+    AtomicFlag mConnected;
+    std::jthread mReceiveThread;
+    std::mutex mMutex;
+
+    ConnectionCallback mOnConnected;
+    ConnectionCallback mOnDisconnected;
+    DataCallback mOnDataReceived;
+};
+
+} // namespace Streaming::Poco
@@ -0,0 +1,194 @@
+#include "WebSocketServer.h"
+#include "ThreadPoolManager.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServerParams.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/NetException.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/WebSocket.h>
+
+namespace Streaming::Poco {
+
+namespace {
+    namespace PocoNet = ::Poco::Net;
+
+    // Poco serves every connection on its own thread for the connection's lifetime,
+    // so this caps the number of concurrent viewers.
+    const int MAX_CONNECTIONS = 1024;
+
+    class WebSocketRequestHandler : public PocoNet::HTTPRequestHandler {
+    public:
+        explicit WebSocketRequestHandler(PocoWebSocketServer& server)
+            : mServer(server)
+        {
+        }
+    public:
+        void handleRequest(PocoNet::HTTPServerRequest& request, PocoNet::HTTPServerResponse& response) override {
+            try {
+                PocoNet::WebSocket webSocket(request, response);
+                Log::Info("Poco WebSocket connection accepted.");
+                mServer.getMetrics().accepted.increment();
+                auto session = std::make_shared<WebSocketSession>(mServer, webSocket);
+                session->run();
+            } catch (const PocoNet::WebSocketException& e) {
+                Log::Warning(Print::composeMessage("Rejected non WebSocket request: ", e.displayText()));
+                response.setStatusAndReason(PocoNet::HTTPResponse::HTTP_BAD_REQUEST);
+                response.setContentLength(0);
+                response.send();
+            } catch (const ::Poco::Exception& e) {
+                Log::Error(Print::composeMessage("Poco Exception in WebSocket handler: ", e.displayText()));
+            }
+        }
+    private:
+        PocoWebSocketServer& mServer;
+    };
+
+    class WebSocketRequestHandlerFactory : public PocoNet::HTTPRequestHandlerFactory {
+    public:
+        explicit WebSocketRequestHandlerFactory(PocoWebSocketServer& server)
+            : mServer(server)
+        {
+        }
+    public:
+        PocoNet::HTTPRequestHandler* createRequestHandler(const PocoNet::HTTPServerRequest&) override {
+            return new WebSocketRequestHandler(mServer);
+        }
+    private:
+        PocoWebSocketServer& mServer;
+    };
+}
+
+PocoWebSocketServer::PocoWebSocketServer()
+    : mRunning(false)
+    , mMetrics(TransportMetrics::create("poco-websocket"))
+{
+    Log::Debug("PocoWebSocketServer created.");
+}
+
+PocoWebSocketServer::~PocoWebSocketServer() {
+    Log::Debug("PocoWebSocketServer destroying...");
+    stop();
+    Log::Debug("PocoWebSocketServer destroyed.");
+}
+
+bool PocoWebSocketServer::start(const std::string& address, int port, int threadCount) {
+    if (mRunning) {
+        Log::Warning("PocoWebSocketServer::start called but server is already running.");
+        return true;
+    }
+
+    Log::Info(Print::composeMessage("Starting PocoWebSocketServer on ", address, ":", port, " with ", threadCount, " writer threads..."));
+
+    try {
+        ThreadPoolManager::Acquire(threadCount > 0 ? threadCount : 4);
+
+        PocoNet::ServerSocket serverSocket(PocoNet::SocketAddress(address, static_cast<::Poco::UInt16>(port)));
+        auto params = new PocoNet::HTTPServerParams;
+        params->setMaxThreads(MAX_CONNECTIONS);
+        params->setMaxQueued(MAX_CONNECTIONS);
+
+        mConnectionPool = std::make_unique<::Poco::ThreadPool>(2, MAX_CONNECTIONS);
+        mHttpServer = std::make_unique<PocoNet::HTTPServer>(new WebSocketRequestHandlerFactory(*this), *mConnectionPool, serverSocket, params);
+
+        mRunning = true;
+        mHttpServer->start();
+
+        Log::Info(Print::composeMessage("PocoWebSocketServer started successfully on ", address, ":", port));
+        return true;
+    } catch (const ::Poco::Exception& e) {
+        Log::Error(Print::composeMessage("Poco Exception during WebSocket server start: ", e.displayText()));
+    } catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Standard exception during WebSocket server start: ", e.what()));
+    }
+
+    mRunning = true;
+    stop();
+    return false;
+}
+
+void PocoWebSocketServer::stop() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+    Log::Info("Stopping PocoWebSocketServer...");
+
+    if (mHttpServer) {
+        mHttpServer->stopAll(true);
+    }
+
+    Log::Debug("Closing active sessions...");
+    SessionStorage sessionsCopy;
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        sessionsCopy = mSessions;
+    }
+    for (const auto& session : sessionsCopy) {
+        session->close();
+    }
+
+    if (mConnectionPool) {
+        mConnectionPool->joinAll();
+    }
+    mHttpServer.reset();
+    mConnectionPool.reset();
+    ThreadPoolManager::Release();
+
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        mSessions.clear();
+        mMetrics.sessions.set(0);
+    }
+    Log::Info("PocoWebSocketServer stopped.");
+}
+
+void PocoWebSocketServer::broadcastData(const std::string& data) {
+    if (!mRunning) {
+        return;
+    }
+
+    // One immutable copy of the frame is shared by every session queue.
+    auto message = std::make_shared<const std::string>(data);
+    SessionStorage sessionsCopy;
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        sessionsCopy = mSessions;
+    }
+    for (const auto& session : sessionsCopy) {
+        session->send(message);
+    }
+}
+
+bool PocoWebSocketServer::isRunning() const {
+    return mRunning;
+}
+
+void PocoWebSocketServer::addSession(WebSocketSessionPtr session) {
+    if (!session) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mSessionsMutex);
+    mSessions.insert(session);
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Session added. Total sessions: {}", mSessions.size());
+}
+
+void PocoWebSocketServer::removeSession(WebSocketSessionPtr session) {
+    if (!session) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mSessionsMutex);
+    mSessions.erase(session);
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Session removed. Total sessions: {}", mSessions.size());
+}
+
+TransportMetrics& PocoWebSocketServer::getMetrics() {
+    return mMetrics;
+}
+
+} // namespace Streaming::Poco
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "IServer.h"
+#include "WebSocketSession.h"
+#include "TransportMetrics.h"
+
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/ThreadPool.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace Streaming::Poco {
+
+class PocoWebSocketServer : public IServer {
+public:
+    PocoWebSocketServer();
+    ~PocoWebSocketServer() override;
+public:
+    bool start(const std::string& address, int port, int threadCount) override;
+    void stop() override;
+    void broadcastData(const std::string& data) override;
+    bool isRunning() const override;
+public:
+    void addSession(WebSocketSessionPtr session);
+    void removeSession(WebSocketSessionPtr session);
+    TransportMetrics& getMetrics();
+private:
+    using HTTPServerPtr = std::unique_ptr<::Poco::Net::HTTPServer>;
+    using ConnectionPoolPtr = std::unique_ptr<::Poco::ThreadPool>;
+    using SessionStorage = std::set<WebSocketSessionPtr>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    ConnectionPoolPtr mConnectionPool;
+    HTTPServerPtr mHttpServer;
+    SessionStorage mSessions;
+    std::mutex mSessionsMutex;
+    AtomicFlag mRunning;
+    TransportMetrics mMetrics;
+};
+
+} // namespace Streaming::Poco
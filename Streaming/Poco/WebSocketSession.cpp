@@ -0,0 +1,179 @@
+#include "WebSocketSession.h"
+#include "WebSocketServer.h"
+#include "ThreadPoolManager.h"
+#include "Log.h"
+#include "Print.h"
+#include "Trace.h"
+
+#include <Poco/Net/NetException.h>
+#include <Poco/Timespan.h>
+
+namespace Streaming::Poco {
+
+namespace {
+    const size_t MAX_QUEUED_MESSAGES = 64;
+    const size_t RECEIVE_BUFFER_SIZE = 1024;
+    const ::Poco::Timespan RECEIVE_TIMEOUT(0, 200000);
+    // A viewer that cannot take a frame within this time is dropped instead of holding a pool worker.
+    const ::Poco::Timespan SEND_TIMEOUT(1, 0);
+    // Frames sent per pool task before the rest is re-enqueued, so the pool shared with
+    // the multicast send pipeline keeps rotating between sessions.
+    const int MAX_FRAMES_PER_TASK = 8;
+}
+
+WebSocketSession::WebSocketSession(PocoWebSocketServer& server, const WebSocket& webSocket)
+    : mServer(server)
+    , mWebSocket(webSocket)
+    , mIsWriting(false)
+    , mIsClosing(false)
+{
+    Log::Debug("Poco WebSocket session created.");
+}
+
+WebSocketSession::~WebSocketSession() {
+    Log::Debug("Poco WebSocket session destroyed.");
+}
+
+void WebSocketSession::run() {
+    namespace PocoNet = ::Poco::Net;
+    mWebSocket.setReceiveTimeout(RECEIVE_TIMEOUT);
+    mWebSocket.setSendTimeout(SEND_TIMEOUT);
+    mServer.addSession(shared_from_this());
+
+    char buffer[RECEIVE_BUFFER_SIZE];
+    while (!mIsClosing) {
+        try {
+            int flags = 0;
+            int bytesReceived = mWebSocket.receiveFrame(buffer, sizeof(buffer), flags);
+            if (bytesReceived == 0 && flags == 0) {
+                Log::Info("Poco WebSocket connection closed by peer.");
+                break;
+            }
+            if ((flags & PocoNet::WebSocket::FRAME_OP_BITMASK) == PocoNet::WebSocket::FRAME_OP_CLOSE) {
+                Log::Info("Poco WebSocket close frame received.");
+                break;
+            }
+        } catch (const ::Poco::TimeoutException&) {
+            continue;
+        } catch (const ::Poco::Exception& e) {
+            if (!mIsClosing) {
+                Log::Error("Poco WebSocket session read error: {}", e.displayText());
+            }
+            break;
+        }
+    }
+
+    close();
+}
+
+void WebSocketSession::send(MessagePtr message) {
+    if (mIsClosing) {
+        return;
+    }
+
+    bool startWriting = false;
+    bool dropped = false;
+    size_t queueDepth = 0;
+    {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        if (mWriteQueue.size() >= MAX_QUEUED_MESSAGES) {
+            mWriteQueue.pop_front();
+            dropped = true;
+        }
+        mWriteQueue.push_back(std::move(message));
+        queueDepth = mWriteQueue.size();
+        if (!mIsWriting) {
+            mIsWriting = true;
+            startWriting = true;
+        }
+    }
+
+    auto& metrics = mServer.getMetrics();
+    metrics.queueDepth.observe(static_cast<double>(queueDepth));
+    if (dropped) {
+        metrics.droppedFrames.increment();
+    }
+
+    if (startWriting && !ThreadPoolManager::Get().enqueue([self = shared_from_this()]() { self->write(); })) {
+        releaseWriter();
+    }
+}
+
+void WebSocketSession::write() {
+    for (int frame = 0; frame < MAX_FRAMES_PER_TASK; ++frame) {
+        MessagePtr message;
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            if (mIsClosing) {
+                break;
+            }
+            if (mWriteQueue.empty()) {
+                mIsWriting = false;
+                return;
+            }
+            message = std::move(mWriteQueue.front());
+            mWriteQueue.pop_front();
+        }
+
+        try {
+            TRACE_SCOPE("Poco::WebSocketSession::write");
+            mWebSocket.sendFrame(message->data(), static_cast<int>(message->size()), ::Poco::Net::WebSocket::FRAME_TEXT);
+        } catch (const ::Poco::Exception& e) {
+            Log::Error("Poco WebSocket session write error: {}", e.displayText());
+            // Still the writer, so close() leaves the shutdown to releaseWriter below.
+            close();
+            break;
+        }
+    }
+
+    if (!mIsClosing && ThreadPoolManager::Get().enqueue([self = shared_from_this()]() { self->write(); })) {
+        return;
+    }
+    releaseWriter();
+}
+
+// Gives up the writer role, or closes the socket when the session was closed while it was held.
+void WebSocketSession::releaseWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        if (!mIsClosing) {
+            mIsWriting = false;
+            return;
+        }
+    }
+    shutdownSocket();
+}
+
+void WebSocketSession::close() {
+    if (mIsClosing.exchange(true)) {
+        return;
+    }
+
+    Log::Debug("Initiating Poco WebSocket session close...");
+    mServer.removeSession(shared_from_this());
+
+    // With a write in flight the writer sends the close frame once its current frame is out.
+    {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        if (mIsWriting) {
+            return;
+        }
+        mIsWriting = true;
+    }
+    shutdownSocket();
+}
+
+void WebSocketSession::shutdownSocket() {
+    try {
+        mWebSocket.shutdown();
+    } catch (const ::Poco::Exception&) {
+        // not interested, the peer may already be gone
+    }
+}
+
+size_t WebSocketSession::getQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mQueueMutex);
+    return mWriteQueue.size();
+}
+
+} // namespace Streaming::Poco
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Poco/Net/WebSocket.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Streaming::Poco {
+
+class PocoWebSocketServer;
+
+// One accepted WebSocket connection. Reads run on the HTTPServer connection thread,
+// writes are queued and drained in order by a single task on the shared thread pool.
+// Only the thread holding the writer role touches the socket for sending, the close
+// frame included, so shutdown never interleaves with a frame being sent.
+class WebSocketSession : public std::enable_shared_from_this<WebSocketSession> {
+public:
+    using WebSocket = ::Poco::Net::WebSocket;
+    using MessagePtr = std::shared_ptr<const std::string>;
+public:
+    WebSocketSession(PocoWebSocketServer& server, const WebSocket& webSocket);
+    ~WebSocketSession();
+public:
+    void run();
+    void send(MessagePtr message);
+    void close();
+    size_t getQueueDepth() const;
+private:
+    void write();
+    void releaseWriter();
+    void shutdownSocket();
+private:
+    using WriteQueue = std::deque<MessagePtr>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    PocoWebSocketServer& mServer;
+    WebSocket mWebSocket;
+    WriteQueue mWriteQueue;
+    mutable std::mutex mQueueMutex;
+    bool mIsWriting;
+    AtomicFlag mIsClosing;
+};
+
+using WebSocketSessionPtr = std::shared_ptr<WebSocketSession>;
+
+} // namespace Streaming::Poco
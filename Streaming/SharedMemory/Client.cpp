@@ -0,0 +1,139 @@
+#include "Client.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <chrono>
+
+namespace Streaming::SharedMemory {
+
+namespace {
+    const char FRAME_DELIMITER = '\n';
+    const int SPIN_ITERATIONS = 64;
+    const int YIELD_ITERATIONS = 64;
+    const std::chrono::microseconds IDLE_SLEEP(500);
+}
+
+SharedMemoryClient::SharedMemoryClient()
+    : mFrameBuffer("")
+    , mNextFrame(0)
+    , mSkippedFrames(0)
+    , mConnected(false)
+{
+}
+
+SharedMemoryClient::~SharedMemoryClient() {
+    disconnect();
+}
+
+bool SharedMemoryClient::connect(const std::string& address, int port) {
+    if (mConnected) {
+        return true;
+    }
+
+    if (!mRing.open(SharedMemoryRing::composeName(address, port))) {
+        Log::Error("Failed to connect to shared memory server");
+        return false;
+    }
+
+    mFrameBuffer.reserve(mRing.getSlotSize());
+    mNextFrame = mRing.getPublishedCount();
+    mSkippedFrames = 0;
+    mConnected = true;
+    mThread = std::jthread([this](std::stop_token stopToken) { poll(stopToken); });
+
+    Log::Info("Shared memory client connected");
+    if (mOnConnected) {
+        mOnConnected();
+    }
+    return true;
+}
+
+void SharedMemoryClient::disconnect() {
+    if (!mConnected.exchange(false)) {
+        return;
+    }
+
+    mThread.request_stop();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    mRing.close();
+
+    Log::Info(Print::composeMessage("Shared memory client disconnected, skipped frames: ", mSkippedFrames));
+    if (mOnDisconnected) {
+        mOnDisconnected();
+    }
+}
+
+void SharedMemoryClient::setOnConnected(ConnectionCallback callback) {
+    mOnConnected = std::move(callback);
+}
+
+void SharedMemoryClient::setOnDisconnected(ConnectionCallback callback) {
+    mOnDisconnected = std::move(callback);
+}
+
+void SharedMemoryClient::setOnDataReceived(DataCallback callback) {
+    mOnDataReceived = std::move(callback);
+}
+
+bool SharedMemoryClient::isConnected() const {
+    return mConnected;
+}
+
+void SharedMemoryClient::poll(std::stop_token stopToken) {
+    int idleIterations = 0;
+    while (!stopToken.stop_requested()) {
+        if (readAvailable()) {
+            idleIterations = 0;
+            continue;
+        }
+
+        ++idleIterations;
+        if (idleIterations <= SPIN_ITERATIONS) {
+            continue;
+        }
+        if (idleIterations <= SPIN_ITERATIONS + YIELD_ITERATIONS) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+bool SharedMemoryClient::readAvailable() {
+    const uint64_t published = mRing.getPublishedCount();
+    if (mNextFrame >= published) {
+        return false;
+    }
+
+    // A reader that fell a whole ring behind jumps to the oldest frame still intact.
+    const uint64_t slotCount = mRing.getSlotCount();
+    if (published - mNextFrame > slotCount) {
+        mSkippedFrames += published - slotCount - mNextFrame;
+        mNextFrame = published - slotCount;
+    }
+
+    while (mNextFrame < published) {
+        auto result = mRing.read(mNextFrame, [this](std::string_view frame) {
+            if (!frame.empty() && frame.back() == FRAME_DELIMITER) {
+                frame.remove_suffix(1);
+            }
+            mFrameBuffer.assign(frame.data(), frame.size());
+        });
+        if (result == SharedMemoryRing::ReadResult::NotReady) {
+            break;
+        }
+        ++mNextFrame;
+        if (result == SharedMemoryRing::ReadResult::Overwritten) {
+            ++mSkippedFrames;
+            continue;
+        }
+        if (mOnDataReceived) {
+            mOnDataReceived(mFrameBuffer);
+        }
+    }
+    return true;
+}
+
+} // namespace Streaming::SharedMemory
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "IClient.h"
+#include "SharedMemoryRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace Streaming::SharedMemory {
+
+// Read-only consumer of a shared memory ring. A polling thread picks up new frames
+// straight from the mapping, so the read path makes no system calls at all; only an
+// idle reader backs off to sleeping.
+class SharedMemoryClient : public IClient {
+public:
+    SharedMemoryClient();
+    ~SharedMemoryClient() override;
+public:
+    bool connect(const std::string& address, int port) override;
+    void disconnect() override;
+    void setOnConnected(ConnectionCallback callback) override;
+    void setOnDisconnected(ConnectionCallback callback) override;
+    void setOnDataReceived(DataCallback callback) override;
+    bool isConnected() const override;
+private:
+    void poll(std::stop_token stopToken);
+    bool readAvailable();
+private:
+    using AtomicFlag = std::atomic<bool>;
+    using Buffer = std::string;
+private:
+    SharedMemoryRing mRing;
+    std::jthread mThread;
+    Buffer mFrameBuffer;
+    uint64_t mNextFrame;
+    uint64_t mSkippedFrames;
+    AtomicFlag mConnected;
+private:
+    ConnectionCallback mOnConnected;
+    ConnectionCallback mOnDisconnected;
+    DataCallback mOnDataReceived;
+};
+
+} // namespace Streaming::SharedMemory
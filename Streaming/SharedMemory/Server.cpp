@@ -0,0 +1,70 @@
+#include "Server.h"
+#include "Log.h"
+#include "Print.h"
+
+namespace Streaming::SharedMemory {
+
+namespace {
+    const uint32_t SLOT_COUNT = 64;
+    const uint32_t SLOT_SIZE = 256 * 1024;
+}
+
+SharedMemoryServer::SharedMemoryServer()
+    : mRunning(false)
+    , mOversizedFrames(0)
+    , mMetrics(TransportMetrics::create("shm"))
+{
+}
+
+SharedMemoryServer::~SharedMemoryServer() {
+    stop();
+}
+
+bool SharedMemoryServer::start(const std::string& address, int port, int /*threadCount*/) {
+    if (mRunning) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mPublishMutex);
+    if (!mRing.create(SharedMemoryRing::composeName(address, port), SLOT_COUNT, SLOT_SIZE)) {
+        Log::Error("Failed to start shared memory server");
+        return false;
+    }
+    mOversizedFrames = 0;
+    mRunning = true;
+    Log::Info("Shared memory server started");
+    return true;
+}
+
+void SharedMemoryServer::stop() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mPublishMutex);
+    if (mOversizedFrames > 0) {
+        Log::Warning(Print::composeMessage("Shared memory server skipped ", mOversizedFrames, " oversized frames"));
+    }
+    mRing.close();
+    Log::Info("Shared memory server stopped");
+}
+
+bool SharedMemoryServer::isRunning() const {
+    return mRunning;
+}
+
+void SharedMemoryServer::broadcastData(const std::string& data) {
+    if (!mRunning) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mPublishMutex);
+    if (!mRing.publish(data)) {
+        mMetrics.droppedFrames.increment();
+        if (mOversizedFrames++ == 0) {
+            Log::Warning(Print::composeMessage("Frame of ", data.size(), " bytes does not fit a shared memory slot of ", mRing.getSlotSize(), " bytes"));
+        }
+    }
+}
+
+} // namespace Streaming::SharedMemory
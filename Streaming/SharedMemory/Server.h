@@ -0,0 +1,34 @@
+#pragma once
+
+#include "IServer.h"
+#include "SharedMemoryRing.h"
+#include "TransportMetrics.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace Streaming::SharedMemory {
+
+// Publishes frames into a shared memory ring for consumers on the same host.
+// There is no per-client state: slow readers simply fall behind and skip frames.
+class SharedMemoryServer : public IServer {
+public:
+    SharedMemoryServer();
+    ~SharedMemoryServer() override;
+public:
+    bool start(const std::string& address, int port, int threadCount = 1) override;
+    void stop() override;
+    bool isRunning() const override;
+    void broadcastData(const std::string& data) override;
+private:
+    using AtomicFlag = std::atomic<bool>;
+private:
+    SharedMemoryRing mRing;
+    std::mutex mPublishMutex;
+    AtomicFlag mRunning;
+    uint64_t mOversizedFrames;
+    TransportMetrics mMetrics;
+};
+
+} // namespace Streaming::SharedMemory
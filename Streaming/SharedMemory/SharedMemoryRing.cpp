@@ -0,0 +1,228 @@
+#include "SharedMemoryRing.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <new>
+
+namespace Streaming::SharedMemory {
+
+namespace {
+    const size_t CACHE_LINE_SIZE = 64;
+    const char* NAME_PREFIX = "/gameoflife-";
+    const mode_t RING_MODE = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+    // The owner holds an exclusive flock on the ring for as long as it lives, so a ring
+    // nobody can lock was left behind by a server that died without unlinking it. A
+    // lockable ring without a size may belong to a server that has not locked it yet.
+    bool removeStaleRing(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return errno == ENOENT;
+        }
+        struct stat info {};
+        const bool stale = ::flock(fd, LOCK_EX | LOCK_NB) == 0 && ::fstat(fd, &info) == 0 && info.st_size > 0;
+        if (stale) {
+            Log::Warning(Print::composeMessage("Removing stale shared memory ring ", name));
+            ::shm_unlink(name.c_str());
+        }
+        ::close(fd);
+        return stale;
+    }
+}
+
+SharedMemoryRing::SharedMemoryRing()
+    : mName("")
+    , mFd(-1)
+    , mMapping(MAP_FAILED)
+    , mMappingSize(0)
+    , mHeader(nullptr)
+    , mOwner(false)
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing() {
+    close();
+}
+
+bool SharedMemoryRing::create(const std::string& name, uint32_t slotCount, uint32_t slotSize) {
+    close();
+
+    const size_t mappingSize = getMappingSize(slotCount, slotSize);
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, RING_MODE);
+    int error = errno;
+    if (fd < 0 && error == EEXIST && removeStaleRing(name)) {
+        fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, RING_MODE);
+        error = errno;
+    }
+    if (fd < 0) {
+        if (error == EEXIST) {
+            Log::Error(Print::composeMessage("Shared memory ring ", name, " is already in use by another server"));
+        }
+        else {
+            Log::Error(Print::composeMessage("shm_open failed for ", name, ": ", std::strerror(error)));
+        }
+        return false;
+    }
+    if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        Log::Error(Print::composeMessage("Shared memory ring ", name, " was taken over while being created"));
+        ::close(fd);
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        Log::Error(Print::composeMessage("ftruncate failed for ", name, ": ", std::strerror(errno)));
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        Log::Error(Print::composeMessage("mmap failed for ", name, ": ", std::strerror(errno)));
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+
+    mName = name;
+    mFd = fd;
+    mMapping = mapping;
+    mMappingSize = mappingSize;
+    mOwner = true;
+
+    // Readers only trust the mapping once the magic is visible, so it is written last.
+    mHeader = new (mapping) Header{ 0, slotCount, slotSize, {} };
+    mHeader->published.store(0, std::memory_order_relaxed);
+    for (uint64_t slot = 0; slot < slotCount; ++slot) {
+        SlotHeader* header = new (getSlot(slot)) SlotHeader{};
+        header->sequence.store(0, std::memory_order_relaxed);
+        header->length.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_ref<uint64_t>(mHeader->magic).store(MAGIC, std::memory_order_release);
+
+    Log::Info(Print::composeMessage("Shared memory ring ", name, " created: ", slotCount, " slots of ", slotSize, " bytes"));
+    return true;
+}
+
+bool SharedMemoryRing::open(const std::string& name) {
+    close();
+
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        Log::Error(Print::composeMessage("shm_open failed for ", name, ": ", std::strerror(errno)));
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        Log::Error(Print::composeMessage("Shared memory ring ", name, " is not initialized"));
+        ::close(fd);
+        return false;
+    }
+    const size_t mappingSize = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        Log::Error(Print::composeMessage("mmap failed for ", name, ": ", std::strerror(errno)));
+        ::close(fd);
+        return false;
+    }
+
+    Header* header = static_cast<Header*>(mapping);
+    const uint64_t magic = std::atomic_ref<uint64_t>(header->magic).load(std::memory_order_acquire);
+    if (magic != MAGIC || header->slotCount == 0 || getMappingSize(header->slotCount, header->slotSize) > mappingSize) {
+        Log::Error(Print::composeMessage("Shared memory ring ", name, " has an unexpected layout"));
+        ::munmap(mapping, mappingSize);
+        ::close(fd);
+        return false;
+    }
+
+    mName = name;
+    mFd = fd;
+    mMapping = mapping;
+    mMappingSize = mappingSize;
+    mHeader = header;
+    mOwner = false;
+    return true;
+}
+
+void SharedMemoryRing::close() {
+    if (mMapping != MAP_FAILED) {
+        ::munmap(mMapping, mMappingSize);
+        mMapping = MAP_FAILED;
+    }
+    // Unlink while still holding the owner lock, a server starting right after the lock
+    // is gone would otherwise create its ring under the name and lose it here.
+    if (mOwner) {
+        ::shm_unlink(mName.c_str());
+        mOwner = false;
+    }
+    if (mFd >= 0) {
+        ::close(mFd);
+        mFd = -1;
+    }
+    mHeader = nullptr;
+    mMappingSize = 0;
+    mName.clear();
+}
+
+bool SharedMemoryRing::isOpen() const {
+    return mHeader != nullptr;
+}
+
+bool SharedMemoryRing::publish(std::string_view frame) {
+    if (!mHeader || !mOwner || frame.size() > mHeader->slotSize) {
+        return false;
+    }
+
+    const uint64_t frameNumber = mHeader->published.load(std::memory_order_relaxed);
+    SlotHeader* slot = getSlot(frameNumber);
+    slot->sequence.store(2 * frameNumber + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(reinterpret_cast<char*>(slot) + sizeof(SlotHeader), frame.data(), frame.size());
+    slot->length.store(static_cast<uint32_t>(frame.size()), std::memory_order_relaxed);
+
+    slot->sequence.store(2 * frameNumber + 2, std::memory_order_release);
+    mHeader->published.store(frameNumber + 1, std::memory_order_release);
+    return true;
+}
+
+uint64_t SharedMemoryRing::getPublishedCount() const {
+    return mHeader ? mHeader->published.load(std::memory_order_acquire) : 0;
+}
+
+uint32_t SharedMemoryRing::getSlotCount() const {
+    return mHeader ? mHeader->slotCount : 0;
+}
+
+uint32_t SharedMemoryRing::getSlotSize() const {
+    return mHeader ? mHeader->slotSize : 0;
+}
+
+std::string SharedMemoryRing::composeName(const std::string& address, int port) {
+    // An explicit POSIX name wins, otherwise the port keeps rings of separate servers apart.
+    if (!address.empty() && address[0] == '/') {
+        return address;
+    }
+    return NAME_PREFIX + std::to_string(port);
+}
+
+size_t SharedMemoryRing::getSlotStride(uint32_t slotSize) {
+    const size_t size = sizeof(SlotHeader) + slotSize;
+    return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+size_t SharedMemoryRing::getMappingSize(uint32_t slotCount, uint32_t slotSize) {
+    return sizeof(Header) + static_cast<size_t>(slotCount) * getSlotStride(slotSize);
+}
+
+SharedMemoryRing::SlotHeader* SharedMemoryRing::getSlot(uint64_t frameNumber) const {
+    char* base = static_cast<char*>(mMapping) + sizeof(Header);
+    return reinterpret_cast<SlotHeader*>(base + (frameNumber % mHeader->slotCount) * getSlotStride(mHeader->slotSize));
+}
+
+} // namespace Streaming::SharedMemory
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace Streaming::SharedMemory {
+
+// Fixed-size ring of frame slots living in a POSIX shared memory object. A single
+// writer publishes frames; any number of readers map the object read-only. Every
+// slot is guarded by a seqlock, so readers never block the writer and a read that
+// raced with an overwrite is detected instead of delivered.
+class SharedMemoryRing {
+public:
+    enum class ReadResult {
+        Ok,
+        NotReady,
+        Overwritten
+    };
+public:
+    SharedMemoryRing();
+    ~SharedMemoryRing();
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+public:
+    // Fails if a live server already owns a ring under the name, a ring left behind by a
+    // crashed one is removed and created anew.
+    bool create(const std::string& name, uint32_t slotCount, uint32_t slotSize);
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const;
+public:
+    bool publish(std::string_view frame);
+    uint64_t getPublishedCount() const;
+    uint32_t getSlotCount() const;
+    uint32_t getSlotSize() const;
+    // The view handed to the visitor points straight into shared memory and is only
+    // trustworthy if read() returns Ok afterwards.
+    template <typename Visitor>
+    ReadResult read(uint64_t frameNumber, Visitor&& visitor) const;
+public:
+    static std::string composeName(const std::string& address, int port);
+private:
+    struct Header {
+        uint64_t magic;
+        uint32_t slotCount;
+        uint32_t slotSize;
+        alignas(64) std::atomic<uint64_t> published;
+    };
+    struct SlotHeader {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint32_t> length;
+    };
+private:
+    static size_t getSlotStride(uint32_t slotSize);
+    static size_t getMappingSize(uint32_t slotCount, uint32_t slotSize);
+    SlotHeader* getSlot(uint64_t frameNumber) const;
+private:
+    static constexpr uint64_t MAGIC = 0x31474E4952464F47; // "GOFRING1"
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+private:
+    std::string mName;
+    int mFd;
+    void* mMapping;
+    size_t mMappingSize;
+    Header* mHeader;
+    bool mOwner;
+};
+
+template <typename Visitor>
+SharedMemoryRing::ReadResult SharedMemoryRing::read(uint64_t frameNumber, Visitor&& visitor) const {
+    const SlotHeader* slot = getSlot(frameNumber);
+    // The writer moves a slot to 2n+1 while filling frame n and to 2n+2 once it is complete.
+    const uint64_t expected = 2 * frameNumber + 2;
+    uint64_t before = slot->sequence.load(std::memory_order_acquire);
+    if (before < expected) {
+        return ReadResult::NotReady;
+    }
+    if (before > expected) {
+        return ReadResult::Overwritten;
+    }
+
+    uint32_t length = std::min(slot->length.load(std::memory_order_relaxed), mHeader->slotSize);
+    const char* data = reinterpret_cast<const char*>(slot) + sizeof(SlotHeader);
+    visitor(std::string_view(data, length));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != before) {
+        return ReadResult::Overwritten;
+    }
+    return ReadResult::Ok;
+}
+
+} // namespace Streaming::SharedMemory
@@ -3,36 +3,133 @@
 #if defined(USE_ASIO)
 #include "Asio/Client.h"
 #include "Asio/Server.h"
-#elif defined(USE_BEAST)
+#endif
+#if defined(USE_BEAST)
 #include "Beast/Client.h"
 #include "Beast/Server.h"
-#elif defined(USE_POCO)
+#endif
+#if defined(USE_POCO)
 #include "Poco/Client.h"
 #include "Poco/Server.h"
-#else
+#include "Poco/WebSocketClient.h"
+#include "Poco/WebSocketServer.h"
+#endif
+#if defined(USE_UNIX_SOCKETS)
+#include "Unix/Client.h"
+#include "Unix/Server.h"
+#endif
+#if defined(USE_IO_URING)
+#include "Uring/Client.h"
+#include "Uring/Server.h"
+#endif
+#if defined(USE_SHARED_MEMORY)
+#include "SharedMemory/Client.h"
+#include "SharedMemory/Server.h"
+#endif
+
+#if !defined(USE_ASIO) && !defined(USE_BEAST) && !defined(USE_POCO) && !defined(USE_UNIX_SOCKETS) && !defined(USE_IO_URING) && !defined(USE_SHARED_MEMORY)
 #error "No streaming implementation selected"
 #endif
 
+#include <stdexcept>
+
 namespace Streaming {
 
+namespace {
+    template <typename Client>
+    ClientPtr createClient() {
+        return std::make_unique<Client>();
+    }
+
+    template <typename Server>
+    ServerPtr createServer() {
+        return std::make_unique<Server>();
+    }
+}
+
 ClientPtr StreamingFactory::CreateClient() {
-#if defined(USE_ASIO)
-    return std::make_unique<Asio::AsioClient>();
-#elif defined(USE_BEAST)
-    return std::make_unique<Beast::BeastClient>();
+    return CreateClient(GetDefaultTransport());
+}
+
+ServerPtr StreamingFactory::CreateServer() {
+    return CreateServer(GetDefaultTransport());
+}
+
+ClientPtr StreamingFactory::CreateClient(const std::string& transport) {
+    return GetTransport(transport).createClient();
+}
+
+ServerPtr StreamingFactory::CreateServer(const std::string& transport) {
+    return GetTransport(transport).createServer();
+}
+
+void StreamingFactory::RegisterTransport(const std::string& transport, ClientCreator clientCreator, ServerCreator serverCreator) {
+    GetRegistry()[transport] = { std::move(clientCreator), std::move(serverCreator) };
+}
+
+bool StreamingFactory::HasTransport(const std::string& transport) {
+    return GetRegistry().contains(transport);
+}
+
+std::vector<std::string> StreamingFactory::GetTransports() {
+    std::vector<std::string> transports;
+    for (const auto& [name, transport] : GetRegistry()) {
+        transports.push_back(name);
+    }
+    return transports;
+}
+
+std::string StreamingFactory::GetDefaultTransport() {
+#if defined(USE_BEAST)
+    return "beast";
+#elif defined(USE_ASIO)
+    return "asio";
 #elif defined(USE_POCO)
-    return std::make_unique<Poco::PocoClient>();
+    return "poco";
+#elif defined(USE_UNIX_SOCKETS)
+    return "unix";
+#elif defined(USE_IO_URING)
+    return "io-uring";
+#else
+    return "shm";
 #endif
 }
 
-ServerPtr StreamingFactory::CreateServer() {
+StreamingFactory::Registry& StreamingFactory::GetRegistry() {
+    static Registry registry = []() {
+        Registry builtIns;
 #if defined(USE_ASIO)
-    return std::make_unique<Asio::AsioServer>();
-#elif defined(USE_BEAST)
-    return std::make_unique<Beast::BeastServer>();
-#elif defined(USE_POCO)
-    return std::make_unique<Poco::PocoServer>();
+        builtIns["asio"] = { createClient<Asio::AsioClient>, createServer<Asio::AsioServer> };
+#endif
+#if defined(USE_BEAST)
+        builtIns["beast"] = { createClient<Beast::BeastClient>, createServer<Beast::BeastServer> };
+#endif
+#if defined(USE_POCO)
+        builtIns["poco"] = { createClient<Poco::PocoClient>, createServer<Poco::PocoServer> };
+        builtIns["poco-websocket"] = { createClient<Poco::PocoWebSocketClient>, createServer<Poco::PocoWebSocketServer> };
+#endif
+#if defined(USE_UNIX_SOCKETS)
+        builtIns["unix"] = { createClient<Unix::UnixStreamClient>, createServer<Unix::UnixStreamServer> };
+        builtIns["unix-seqpacket"] = { createClient<Unix::UnixSeqPacketClient>, createServer<Unix::UnixSeqPacketServer> };
 #endif
+#if defined(USE_IO_URING)
+        builtIns["io-uring"] = { createClient<Uring::UringClient>, createServer<Uring::UringServer> };
+#endif
+#if defined(USE_SHARED_MEMORY)
+        builtIns["shm"] = { createClient<SharedMemory::SharedMemoryClient>, createServer<SharedMemory::SharedMemoryServer> };
+#endif
+        return builtIns;
+    }();
+    return registry;
+}
+
+const StreamingFactory::Transport& StreamingFactory::GetTransport(const std::string& transport) {
+    const auto& registry = GetRegistry();
+    auto it = registry.find(transport);
+    if (it == registry.end()) {
+        throw std::runtime_error("Unknown streaming transport: " + transport);
+    }
+    return it->second;
 }
 
 } // namespace Streaming
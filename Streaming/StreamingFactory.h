@@ -2,15 +2,37 @@
 
 #include "IClient.h"
 #include "IServer.h"
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Streaming {
 
 class StreamingFactory {
+public:
+    using ClientCreator = std::function<ClientPtr()>;
+    using ServerCreator = std::function<ServerPtr()>;
 public:
     static ClientPtr CreateClient();
     static ServerPtr CreateServer();
+    static ClientPtr CreateClient(const std::string& transport);
+    static ServerPtr CreateServer(const std::string& transport);
+public:
+    static void RegisterTransport(const std::string& transport, ClientCreator clientCreator, ServerCreator serverCreator);
+    static bool HasTransport(const std::string& transport);
+    static std::vector<std::string> GetTransports();
+    static std::string GetDefaultTransport();
+private:
+    struct Transport {
+        ClientCreator createClient;
+        ServerCreator createServer;
+    };
+    using Registry = std::map<std::string, Transport>;
+private:
+    static Registry& GetRegistry();
+    static const Transport& GetTransport(const std::string& transport);
 };
 
 } // namespace Streaming
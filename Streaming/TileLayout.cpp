@@ -0,0 +1,127 @@
+#include "TileLayout.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+namespace Streaming {
+
+namespace {
+    const char TILE_MARKER = 'T';
+    const int TILE_COORDINATE_DIGITS = 4;
+
+    // 224.0.0.0/4, every tile group has to stay inside it.
+    const uint32_t MULTICAST_PREFIX = 0xE0000000;
+    const uint32_t MULTICAST_MASK = 0xF0000000;
+}
+
+const size_t TileLayout::TILE_HEADER_LENGTH = 1 + 2 * TILE_COORDINATE_DIGITS;
+
+TileLayout::TileLayout(int worldWidth, int worldHeight, int tileWidth, int tileHeight)
+    : mWorldWidth(worldWidth)
+    , mWorldHeight(worldHeight)
+    , mTileWidth(std::clamp(tileWidth, 1, std::max(worldWidth, 1)))
+    , mTileHeight(std::clamp(tileHeight, 1, std::max(worldHeight, 1)))
+{
+    mColumns = (mWorldWidth + mTileWidth - 1) / mTileWidth;
+    mRows = (mWorldHeight + mTileHeight - 1) / mTileHeight;
+}
+
+int TileLayout::getTileCount() const {
+    return mColumns * mRows;
+}
+
+int TileLayout::getColumns() const {
+    return mColumns;
+}
+
+int TileLayout::getRows() const {
+    return mRows;
+}
+
+int TileLayout::getTileIndex(int column, int row) const {
+    return row * mColumns + column;
+}
+
+TileLayout::Rect TileLayout::getTileRect(int tileIndex) const {
+    int column = tileIndex % mColumns;
+    int row = tileIndex / mColumns;
+    int x = column * mTileWidth;
+    int y = row * mTileHeight;
+    return { x, y, std::min(mTileWidth, mWorldWidth - x), std::min(mTileHeight, mWorldHeight - y) };
+}
+
+std::vector<int> TileLayout::getTilesInRect(const Rect& rect) const {
+    std::vector<int> tiles;
+    if (rect.width <= 0 || rect.height <= 0) {
+        return tiles;
+    }
+
+    int firstColumn = std::clamp(rect.x / mTileWidth, 0, mColumns - 1);
+    int lastColumn = std::clamp((rect.x + rect.width - 1) / mTileWidth, 0, mColumns - 1);
+    int firstRow = std::clamp(rect.y / mTileHeight, 0, mRows - 1);
+    int lastRow = std::clamp((rect.y + rect.height - 1) / mTileHeight, 0, mRows - 1);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            tiles.push_back(getTileIndex(column, row));
+        }
+    }
+    return tiles;
+}
+
+std::string TileLayout::getGroupAddress(const std::string& baseAddress, int tileIndex) {
+    std::istringstream iss(baseAddress);
+    std::string segment;
+    uint32_t address = 0;
+    int count = 0;
+    while (std::getline(iss, segment, '.')) {
+        if (segment.empty() || segment.size() > 3 || !std::all_of(segment.begin(), segment.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            return "";
+        }
+        int octet = std::stoi(segment);
+        if (octet > 255 || ++count > 4) {
+            return "";
+        }
+        address = (address << 8) | static_cast<uint32_t>(octet);
+    }
+    if (count != 4 || tileIndex < 0) {
+        return "";
+    }
+
+    // Tiles start right after the base group, a tiled server sends nothing to the base group itself.
+    const uint64_t tileAddress = static_cast<uint64_t>(address) + static_cast<uint64_t>(tileIndex) + 1;
+    if (tileAddress > UINT32_MAX || (static_cast<uint32_t>(tileAddress) & MULTICAST_MASK) != MULTICAST_PREFIX) {
+        return "";
+    }
+    address = static_cast<uint32_t>(tileAddress);
+
+    std::ostringstream oss;
+    oss << ((address >> 24) & 0xFF) << '.' << ((address >> 16) & 0xFF) << '.' << ((address >> 8) & 0xFF) << '.' << (address & 0xFF);
+    return oss.str();
+}
+
+std::string TileLayout::composeTileHeader(int x, int y) {
+    std::ostringstream ss;
+    ss << TILE_MARKER
+       << std::setw(TILE_COORDINATE_DIGITS) << std::setfill('0') << x
+       << std::setw(TILE_COORDINATE_DIGITS) << std::setfill('0') << y;
+    return ss.str();
+}
+
+bool TileLayout::parseTileHeader(const std::string& frame, int& x, int& y) {
+    if (frame.length() < TILE_HEADER_LENGTH || frame[0] != TILE_MARKER) {
+        return false;
+    }
+    try {
+        x = std::stoi(frame.substr(1, TILE_COORDINATE_DIGITS));
+        y = std::stoi(frame.substr(1 + TILE_COORDINATE_DIGITS, TILE_COORDINATE_DIGITS));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return x >= 0 && y >= 0;
+}
+
+} // namespace Streaming
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Streaming {
+
+// Splits a world grid into fixed-size tiles. Every tile is published on its own
+// multicast group, derived from the base group address plus the tile index.
+class TileLayout {
+public:
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+public:
+    TileLayout(int worldWidth, int worldHeight, int tileWidth, int tileHeight);
+public:
+    int getTileCount() const;
+    int getColumns() const;
+    int getRows() const;
+    int getTileIndex(int column, int row) const;
+    Rect getTileRect(int tileIndex) const;
+    std::vector<int> getTilesInRect(const Rect& rect) const;
+public:
+    // Empty when the base is not an IPv4 address or the tile group would leave 224.0.0.0/4.
+    static std::string getGroupAddress(const std::string& baseAddress, int tileIndex);
+    static std::string composeTileHeader(int x, int y);
+    static bool parseTileHeader(const std::string& frame, int& x, int& y);
+public:
+    static const size_t TILE_HEADER_LENGTH;
+private:
+    int mWorldWidth;
+    int mWorldHeight;
+    int mTileWidth;
+    int mTileHeight;
+    int mColumns;
+    int mRows;
+};
+
+} // namespace Streaming
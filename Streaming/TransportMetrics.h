@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Metrics.h"
+
+#include <string>
+
+namespace Streaming {
+
+// Metrics every server transport reports, labelled with the transport name so a single
+// scrape compares them side by side. Transports without sessions leave those at zero.
+// Header only: the transport libraries are linked into Streaming, not the other way round.
+struct TransportMetrics {
+    Metrics::Counter& accepted;
+    Metrics::Gauge& sessions;
+    Metrics::Counter& droppedFrames;
+    Metrics::Histogram& queueDepth;
+public:
+    static TransportMetrics create(const std::string& transport) {
+        auto& registry = Metrics::Registry::Get();
+        const Metrics::Labels labels{ { "transport", transport } };
+        return TransportMetrics{
+            registry.getCounter("gameoflife_transport_accepted_total", "Connections accepted by the transport", labels),
+            registry.getGauge("gameoflife_transport_sessions", "Currently open sessions", labels),
+            registry.getCounter("gameoflife_transport_dropped_frames_total", "Frames dropped because a queue was full or the frame did not fit", labels),
+            registry.getHistogram("gameoflife_transport_queue_depth", "Frames waiting in a session send queue, observed on every enqueue",
+                Metrics::Histogram::exponentialBounds(1, 2, 8), labels)
+        };
+    }
+};
+
+} // namespace Streaming
@@ -0,0 +1,161 @@
+#include "Client.h"
+#include "Log.h"
+#include "Print.h"
+
+namespace Streaming::Unix {
+
+namespace {
+    // A seqpacket receive truncates anything that does not fit, so the buffer holds a whole frame.
+    const size_t RECEIVE_BUFFER_SIZE = 1024 * 1024;
+    const char FRAME_DELIMITER = '\n';
+}
+
+template <typename Protocol>
+UnixClient<Protocol>::UnixClient()
+    : mIoContext()
+    , mSocket(mIoContext)
+    , mReceiveBuffer(RECEIVE_BUFFER_SIZE, '\0')
+    , mFrameBuffer("")
+    , mReceiveFlags(0)
+    , mRunning(false)
+    , mConnected(false)
+{
+}
+
+template <typename Protocol>
+UnixClient<Protocol>::~UnixClient() {
+    disconnect();
+}
+
+template <typename Protocol>
+bool UnixClient<Protocol>::connect(const std::string& address, int port) {
+    if (mRunning) {
+        Log::Warning("Unix client is already running, disconnect first.");
+        return mConnected;
+    }
+
+    const std::string socketPath = composeSocketPath(address, port);
+    try {
+        Log::Info(Print::composeMessage("Connecting to Unix ", Traits::NAME, " server at ", socketPath));
+        mIoContext.restart();
+        mSocket.connect(typename Protocol::endpoint(socketPath));
+        mFrameBuffer.clear();
+
+        mConnected = true;
+        mRunning = true;
+        mWork.emplace(boost::asio::make_work_guard(mIoContext));
+        mThread = std::jthread([this]() {
+            try {
+                mIoContext.run();
+            } catch (const std::exception& e) {
+                Log::Error(Print::composeMessage("Exception in Unix client thread: ", e.what()));
+            }
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mOnConnected) {
+                mOnConnected();
+            }
+        }
+
+        boost::asio::post(mIoContext, [this]() { read(); });
+        return true;
+    } catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Failed to connect to ", socketPath, ": ", e.what()));
+        boost::system::error_code ignored;
+        mSocket.close(ignored);
+        mConnected = false;
+        return false;
+    }
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::disconnect() {
+    if (!mRunning.exchange(false)) {
+        return;
+    }
+
+    Log::Info(Print::composeMessage("Disconnecting from Unix ", Traits::NAME, " server..."));
+    boost::asio::post(mIoContext, [this]() {
+        boost::system::error_code ignored;
+        mSocket.shutdown(Socket::shutdown_both, ignored);
+        mSocket.close(ignored);
+    });
+
+    mWork.reset();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    handleClosed();
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::setOnConnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnConnected = std::move(callback);
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::setOnDisconnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDisconnected = std::move(callback);
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::setOnDataReceived(DataCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDataReceived = std::move(callback);
+}
+
+template <typename Protocol>
+bool UnixClient<Protocol>::isConnected() const {
+    return mConnected;
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::read() {
+    Traits::asyncReceive(mSocket, boost::asio::buffer(mReceiveBuffer), mReceiveFlags,
+        [this](const boost::system::error_code& ec, size_t bytesReceived) {
+            if (ec) {
+                if (ec != boost::asio::error::operation_aborted && mRunning) {
+                    Log::Info("Unix {} connection closed: {}", Traits::NAME, ec.message());
+                }
+                handleClosed();
+                return;
+            }
+
+            mFrameBuffer.append(mReceiveBuffer.data(), bytesReceived);
+            size_t frameStart = 0;
+            size_t delimiterPos = mFrameBuffer.find(FRAME_DELIMITER);
+            while (delimiterPos != std::string::npos) {
+                if (delimiterPos > frameStart) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (mOnDataReceived) {
+                        mOnDataReceived(mFrameBuffer.substr(frameStart, delimiterPos - frameStart));
+                    }
+                }
+                frameStart = delimiterPos + 1;
+                delimiterPos = mFrameBuffer.find(FRAME_DELIMITER, frameStart);
+            }
+            mFrameBuffer.erase(0, frameStart);
+            read();
+        });
+}
+
+template <typename Protocol>
+void UnixClient<Protocol>::handleClosed() {
+    if (!mConnected.exchange(false)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mOnDisconnected) {
+        mOnDisconnected();
+    }
+}
+
+template class UnixClient<StreamProtocol>;
+template class UnixClient<SeqPacketProtocol>;
+
+} // namespace Streaming::Unix
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "IClient.h"
+#include "Protocol.h"
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace Streaming::Unix {
+
+template <typename Protocol>
+class UnixClient : public IClient {
+public:
+    UnixClient();
+    ~UnixClient() override;
+public:
+    bool connect(const std::string& address, int port) override;
+    void disconnect() override;
+    void setOnConnected(ConnectionCallback callback) override;
+    void setOnDisconnected(ConnectionCallback callback) override;
+    void setOnDataReceived(DataCallback callback) override;
+    bool isConnected() const override;
+private:
+    void read();
+    void handleClosed();
+private:
+    using Traits = ProtocolTraits<Protocol>;
+    using IoContext = boost::asio::io_context;
+    using WorkGuard = boost::asio::executor_work_guard<IoContext::executor_type>;
+    using WorkGuardOptional = std::optional<WorkGuard>;
+    using Socket = typename Protocol::socket;
+    using Buffer = std::string;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    IoContext mIoContext;
+    Socket mSocket;
+    WorkGuardOptional mWork;
+    Buffer mReceiveBuffer;
+    Buffer mFrameBuffer;
+    MessageFlags mReceiveFlags;
+    std::jthread mThread;
+    AtomicFlag mRunning;
+    AtomicFlag mConnected;
+    std::mutex mMutex;
+private:
+    ConnectionCallback mOnConnected;
+    ConnectionCallback mOnDisconnected;
+    DataCallback mOnDataReceived;
+};
+
+using UnixStreamClient = UnixClient<StreamProtocol>;
+using UnixSeqPacketClient = UnixClient<SeqPacketProtocol>;
+
+} // namespace Streaming::Unix
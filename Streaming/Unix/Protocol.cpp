@@ -0,0 +1,17 @@
+#include "Protocol.h"
+
+namespace Streaming::Unix {
+
+namespace {
+    const char* SOCKET_PATH_PREFIX = "/tmp/gameoflife-";
+    const char* SOCKET_PATH_SUFFIX = ".sock";
+}
+
+std::string composeSocketPath(const std::string& address, int port) {
+    if (address.find('/') != std::string::npos) {
+        return address;
+    }
+    return SOCKET_PATH_PREFIX + std::to_string(port) + SOCKET_PATH_SUFFIX;
+}
+
+} // namespace Streaming::Unix
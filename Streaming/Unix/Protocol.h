@@ -0,0 +1,66 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/asio/local/basic_endpoint.hpp>
+
+#include <sys/socket.h>
+
+#include <string>
+
+namespace Streaming::Unix {
+
+using StreamProtocol = boost::asio::local::stream_protocol;
+using MessageFlags = boost::asio::socket_base::message_flags;
+
+// Local seqpacket protocol, only shipped with newer Boost releases, spelled out the same way.
+class SeqPacketProtocol {
+public:
+    using endpoint = boost::asio::local::basic_endpoint<SeqPacketProtocol>;
+    using socket = boost::asio::basic_seq_packet_socket<SeqPacketProtocol>;
+    using acceptor = boost::asio::basic_socket_acceptor<SeqPacketProtocol>;
+public:
+    int type() const { return SOCK_SEQPACKET; }
+    int protocol() const { return 0; }
+    int family() const { return AF_UNIX; }
+};
+
+// Maps a server address and port onto a socket path. An address that already looks
+// like a path is used as is, otherwise the port keeps sockets of separate servers apart.
+std::string composeSocketPath(const std::string& address, int port);
+
+// Per-protocol I/O: a stream socket needs newline framing and may complete partial
+// writes, a seqpacket socket keeps message boundaries and sends each frame whole.
+template <typename Protocol>
+struct ProtocolTraits;
+
+template <>
+struct ProtocolTraits<StreamProtocol> {
+    static constexpr const char* NAME = "stream";
+
+    template <typename Socket, typename Handler>
+    static void asyncSend(Socket& socket, boost::asio::const_buffer buffer, Handler&& handler) {
+        boost::asio::async_write(socket, buffer, std::forward<Handler>(handler));
+    }
+
+    template <typename Socket, typename Handler>
+    static void asyncReceive(Socket& socket, boost::asio::mutable_buffer buffer, MessageFlags& /*flags*/, Handler&& handler) {
+        socket.async_read_some(buffer, std::forward<Handler>(handler));
+    }
+};
+
+template <>
+struct ProtocolTraits<SeqPacketProtocol> {
+    static constexpr const char* NAME = "seqpacket";
+
+    template <typename Socket, typename Handler>
+    static void asyncSend(Socket& socket, boost::asio::const_buffer buffer, Handler&& handler) {
+        socket.async_send(buffer, 0, std::forward<Handler>(handler));
+    }
+
+    template <typename Socket, typename Handler>
+    static void asyncReceive(Socket& socket, boost::asio::mutable_buffer buffer, MessageFlags& flags, Handler&& handler) {
+        socket.async_receive(buffer, flags, std::forward<Handler>(handler));
+    }
+};
+
+} // namespace Streaming::Unix
@@ -0,0 +1,190 @@
+#include "Server.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <filesystem>
+
+namespace Streaming::Unix {
+
+template <typename Protocol>
+UnixServer<Protocol>::UnixServer()
+    : mAcceptor(mIoContext)
+    , mRunning(false)
+    , mMetrics(TransportMetrics::create(std::string("unix-") + Traits::NAME))
+{
+    Log::Debug("Unix {} server creating...", Traits::NAME);
+}
+
+template <typename Protocol>
+UnixServer<Protocol>::~UnixServer() {
+    Log::Debug("Unix {} server destroying...", Traits::NAME);
+    if (mRunning) {
+        stop();
+    }
+}
+
+template <typename Protocol>
+bool UnixServer<Protocol>::start(const std::string& address, int port, int threadCount) {
+    if (mRunning) {
+        Log::Warning("UnixServer::start called but server is already running.");
+        return true;
+    }
+
+    try {
+        mSocketPath = composeSocketPath(address, port);
+        Log::Info(Print::composeMessage("Starting Unix ", Traits::NAME, " server on ", mSocketPath, " with ", threadCount, " threads..."));
+
+        // A socket file left behind by a previous run would make bind fail.
+        std::error_code removeError;
+        std::filesystem::remove(mSocketPath, removeError);
+
+        typename Protocol::endpoint endpoint(mSocketPath);
+        mAcceptor.open(endpoint.protocol());
+        mAcceptor.bind(endpoint);
+        mAcceptor.listen();
+
+        mRunning = true;
+        mWork.emplace(boost::asio::make_work_guard(mIoContext));
+        accept();
+
+        mThreadPool.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            mThreadPool.emplace_back([this, i]() {
+                try {
+                    Log::Debug("Unix server thread started: {}", i);
+                    mIoContext.run();
+                    Log::Debug("Unix server thread exiting: {}", i);
+                } catch (const std::exception& e) {
+                    Log::Error(Print::composeMessage("Unix server thread exception: ", e.what()));
+                }
+            });
+        }
+
+        Log::Info(Print::composeMessage("Unix ", Traits::NAME, " server started on ", mSocketPath));
+        return true;
+    } catch (const std::exception& e) {
+        Log::Error(Print::composeMessage("Failed to start Unix ", Traits::NAME, " server: ", e.what()));
+        boost::system::error_code ignored;
+        mAcceptor.close(ignored);
+        mRunning = false;
+        return false;
+    }
+}
+
+template <typename Protocol>
+void UnixServer<Protocol>::stop() {
+    if (!mRunning.exchange(false)) {
+        Log::Warning("UnixServer::stop called but server is not running.");
+        return;
+    }
+    Log::Info(Print::composeMessage("Stopping Unix ", Traits::NAME, " server..."));
+
+    boost::asio::post(mIoContext, [this]() {
+        boost::system::error_code ignored;
+        mAcceptor.close(ignored);
+    });
+
+    SessionStorage sessionsCopy;
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        sessionsCopy = mSessions;
+    }
+    for (const auto& session : sessionsCopy) {
+        session->close();
+    }
+
+    mWork.reset();
+    for (auto& thread : mThreadPool) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    mThreadPool.clear();
+    mIoContext.stop();
+    mIoContext.restart();
+
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        mSessions.clear();
+        mMetrics.sessions.set(0);
+    }
+
+    std::error_code removeError;
+    std::filesystem::remove(mSocketPath, removeError);
+
+    Log::Info(Print::composeMessage("Unix ", Traits::NAME, " server stopped."));
+}
+
+template <typename Protocol>
+void UnixServer<Protocol>::broadcastData(const std::string& data) {
+    if (!mRunning) {
+        return;
+    }
+
+    SessionStorage sessionsCopy;
+    {
+        std::lock_guard<std::mutex> lock(mSessionsMutex);
+        if (mSessions.empty()) {
+            return;
+        }
+        sessionsCopy = mSessions;
+    }
+
+    auto message = std::make_shared<const std::string>(data);
+    for (const auto& session : sessionsCopy) {
+        session->send(message);
+    }
+}
+
+template <typename Protocol>
+bool UnixServer<Protocol>::isRunning() const {
+    return mRunning;
+}
+
+template <typename Protocol>
+void UnixServer<Protocol>::addSession(SessionPtr session) {
+    std::lock_guard<std::mutex> lock(mSessionsMutex);
+    mSessions.insert(std::move(session));
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Unix session added. Total sessions: {}", mSessions.size());
+}
+
+template <typename Protocol>
+void UnixServer<Protocol>::removeSession(SessionPtr session) {
+    std::lock_guard<std::mutex> lock(mSessionsMutex);
+    mSessions.erase(session);
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    Log::Debug("Unix session removed. Total sessions: {}", mSessions.size());
+}
+
+template <typename Protocol>
+TransportMetrics& UnixServer<Protocol>::getMetrics() {
+    return mMetrics;
+}
+
+template <typename Protocol>
+void UnixServer<Protocol>::accept() {
+    mAcceptor.async_accept(boost::asio::make_strand(mIoContext),
+        [this](const boost::system::error_code& ec, typename Protocol::socket socket) {
+            if (!mRunning) {
+                return;
+            }
+            if (ec) {
+                if (ec != boost::asio::error::operation_aborted) {
+                    Log::Error(Print::composeMessage("Unix accept error: ", ec.message()));
+                    accept();
+                }
+                return;
+            }
+
+            mMetrics.accepted.increment();
+            Log::Info(Print::composeMessage("Unix ", Traits::NAME, " connection accepted."));
+            std::make_shared<UnixSession<Protocol>>(*this, std::move(socket))->run();
+            accept();
+        });
+}
+
+template class UnixServer<StreamProtocol>;
+template class UnixServer<SeqPacketProtocol>;
+
+} // namespace Streaming::Unix
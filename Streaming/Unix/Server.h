@@ -0,0 +1,64 @@
+#pragma once
+
+#include "IServer.h"
+#include "Protocol.h"
+#include "Session.h"
+#include "TransportMetrics.h"
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Streaming::Unix {
+
+// Broadcasts frames to local viewers over a Unix domain socket. Same fan-out as the
+// Beast server, minus the TCP stack and WebSocket framing.
+template <typename Protocol>
+class UnixServer : public IServer {
+public:
+    using SessionPtr = std::shared_ptr<UnixSession<Protocol>>;
+public:
+    UnixServer();
+    ~UnixServer() override;
+public:
+    bool start(const std::string& address, int port, int threadCount = 1) override;
+    void stop() override;
+    void broadcastData(const std::string& data) override;
+    bool isRunning() const override;
+public:
+    void addSession(SessionPtr session);
+    void removeSession(SessionPtr session);
+    TransportMetrics& getMetrics();
+private:
+    void accept();
+private:
+    using Traits = ProtocolTraits<Protocol>;
+    using IoContext = boost::asio::io_context;
+    using Acceptor = typename Protocol::acceptor;
+    using SessionStorage = std::set<SessionPtr>;
+    using ThreadPool = std::vector<std::jthread>;
+    using AtomicFlag = std::atomic<bool>;
+    using WorkOptional = std::optional<boost::asio::executor_work_guard<IoContext::executor_type>>;
+private:
+    IoContext mIoContext;
+    WorkOptional mWork;
+    Acceptor mAcceptor;
+    std::string mSocketPath;
+    SessionStorage mSessions;
+    std::mutex mSessionsMutex;
+    AtomicFlag mRunning;
+    ThreadPool mThreadPool;
+    TransportMetrics mMetrics;
+};
+
+using UnixStreamServer = UnixServer<StreamProtocol>;
+using UnixSeqPacketServer = UnixServer<SeqPacketProtocol>;
+
+} // namespace Streaming::Unix
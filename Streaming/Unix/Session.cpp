@@ -0,0 +1,139 @@
+#include "Session.h"
+#include "Server.h"
+#include "Log.h"
+#include "Print.h"
+#include "Trace.h"
+
+namespace Streaming::Unix {
+
+namespace {
+    const size_t MAX_QUEUED_MESSAGES = 64;
+    const int SEND_BUFFER_SIZE = 4 * 1024 * 1024;
+}
+
+template <typename Protocol>
+UnixSession<Protocol>::UnixSession(UnixServer<Protocol>& server, Socket&& socket)
+    : mServer(server)
+    , mSocket(std::move(socket))
+    , mReadBuffer()
+    , mReadFlags(0)
+    , mIsClosing(false)
+{
+    Log::Debug("Unix {} session created.", Traits::NAME);
+}
+
+template <typename Protocol>
+UnixSession<Protocol>::~UnixSession() {
+    Log::Debug("Unix {} session destroyed.", Traits::NAME);
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::run() {
+    // A seqpacket frame has to fit the socket send buffer whole; the kernel caps the request at its maximum.
+    boost::system::error_code ec;
+    mSocket.set_option(boost::asio::socket_base::send_buffer_size(SEND_BUFFER_SIZE), ec);
+
+    mServer.addSession(this->shared_from_this());
+    boost::asio::dispatch(mSocket.get_executor(), [self = this->shared_from_this()]() {
+        self->read();
+    });
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::read() {
+    // Viewers never send anything meaningful, reading only tells us when the peer goes away.
+    Traits::asyncReceive(mSocket, boost::asio::buffer(mReadBuffer), mReadFlags,
+        [self = this->shared_from_this()](const boost::system::error_code& ec, size_t) {
+            if (self->mIsClosing) {
+                return;
+            }
+            if (ec == boost::asio::error::eof) {
+                Log::Info("Unix {} connection closed by peer.", Traits::NAME);
+                self->close();
+                return;
+            }
+            if (ec) {
+                self->fail(ec, "read");
+                return;
+            }
+            self->read();
+        });
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::send(MessagePtr message) {
+    if (mIsClosing) {
+        return;
+    }
+
+    boost::asio::post(mSocket.get_executor(), [self = this->shared_from_this(), message = std::move(message)]() {
+        if (self->mIsClosing) {
+            return;
+        }
+
+        auto& queue = self->mWriteQueue;
+        const bool startWriting = queue.empty();
+        if (queue.size() >= MAX_QUEUED_MESSAGES) {
+            // The front frame is in flight, the oldest one still waiting makes room.
+            queue.erase(queue.begin() + 1);
+            self->mServer.getMetrics().droppedFrames.increment();
+        }
+        queue.push_back(std::move(message));
+        self->mServer.getMetrics().queueDepth.observe(static_cast<double>(queue.size()));
+
+        if (startWriting) {
+            self->write();
+        }
+    });
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::write() {
+    TRACE_SCOPE("Unix::Session::write");
+    const MessagePtr& message = mWriteQueue.front();
+    Traits::asyncSend(mSocket, boost::asio::buffer(*message),
+        [self = this->shared_from_this()](const boost::system::error_code& ec, size_t) {
+            if (self->mIsClosing) {
+                return;
+            }
+            if (ec) {
+                self->fail(ec, "write");
+                return;
+            }
+
+            self->mWriteQueue.pop_front();
+            if (!self->mWriteQueue.empty()) {
+                self->write();
+            }
+        });
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::fail(const boost::system::error_code& ec, const std::string& what) {
+    if (ec != boost::asio::error::operation_aborted) {
+        Log::Error("Unix {} session error ({}): {}", Traits::NAME, what, ec.message());
+    }
+    close();
+}
+
+template <typename Protocol>
+void UnixSession<Protocol>::close() {
+    if (mIsClosing.exchange(true)) {
+        return;
+    }
+
+    Log::Debug("Initiating Unix {} session close...", Traits::NAME);
+    mServer.removeSession(this->shared_from_this());
+
+    boost::asio::post(mSocket.get_executor(), [self = this->shared_from_this()]() {
+        boost::system::error_code ignored;
+        self->mSocket.shutdown(Socket::shutdown_both, ignored);
+        self->mSocket.close(ignored);
+        self->mWriteQueue.clear();
+    });
+}
+
+template class UnixSession<StreamProtocol>;
+template class UnixSession<SeqPacketProtocol>;
+
+} // namespace Streaming::Unix
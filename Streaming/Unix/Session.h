@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Protocol.h"
+
+#include <boost/asio.hpp>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace Streaming::Unix {
+
+template <typename Protocol>
+class UnixServer;
+
+// One accepted local connection. All socket work runs on the session strand, so the
+// write queue needs no lock; frames are shared between sessions instead of copied.
+template <typename Protocol>
+class UnixSession : public std::enable_shared_from_this<UnixSession<Protocol>> {
+public:
+    using Socket = typename Protocol::socket;
+    using MessagePtr = std::shared_ptr<const std::string>;
+public:
+    UnixSession(UnixServer<Protocol>& server, Socket&& socket);
+    ~UnixSession();
+public:
+    void run();
+    void send(MessagePtr message);
+    void close();
+private:
+    void read();
+    void write();
+    void fail(const boost::system::error_code& ec, const std::string& what);
+private:
+    using Traits = ProtocolTraits<Protocol>;
+    using WriteQueue = std::deque<MessagePtr>;
+    using ReadBuffer = std::array<char, 256>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    UnixServer<Protocol>& mServer;
+    Socket mSocket;
+    ReadBuffer mReadBuffer;
+    MessageFlags mReadFlags;
+    WriteQueue mWriteQueue;
+    AtomicFlag mIsClosing;
+};
+
+} // namespace Streaming::Unix
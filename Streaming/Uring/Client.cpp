@@ -0,0 +1,152 @@
+#include "Client.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace Streaming::Uring {
+
+namespace {
+    const size_t RECEIVE_BUFFER_SIZE = 256 * 1024;
+    const int POLL_TIMEOUT_MS = 200;
+    const char FRAME_DELIMITER = '\n';
+}
+
+UringClient::UringClient()
+    : mSocket(-1)
+    , mReceiveBuffer(RECEIVE_BUFFER_SIZE, '\0')
+    , mFrameBuffer("")
+    , mConnected(false)
+{
+}
+
+UringClient::~UringClient() {
+    disconnect();
+}
+
+bool UringClient::connect(const std::string& address, int port) {
+    if (mConnected) {
+        Log::Warning("Already connected, disconnect first.");
+        return false;
+    }
+    disconnect();
+
+    sockaddr_in endpoint;
+    std::memset(&endpoint, 0, sizeof(endpoint));
+    endpoint.sin_family = AF_INET;
+    endpoint.sin_port = htons(static_cast<uint16_t>(port));
+    if (::inet_pton(AF_INET, address.c_str(), &endpoint.sin_addr) != 1) {
+        Log::Error(Print::composeMessage("Invalid server address: ", address));
+        return false;
+    }
+
+    mSocket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (mSocket < 0 || ::connect(mSocket, reinterpret_cast<sockaddr*>(&endpoint), sizeof(endpoint)) != 0) {
+        Log::Error(Print::composeMessage("Failed to connect to ", address, ":", port, ": ", std::strerror(errno)));
+        if (mSocket >= 0) {
+            ::close(mSocket);
+            mSocket = -1;
+        }
+        return false;
+    }
+
+    Log::Info(Print::composeMessage("Connected to TCP server at ", address, ":", port));
+    mFrameBuffer.clear();
+    mConnected = true;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mOnConnected) {
+            mOnConnected();
+        }
+    }
+    mThread = std::jthread([this](std::stop_token stopToken) { receive(stopToken); });
+    return true;
+}
+
+void UringClient::disconnect() {
+    if (mThread.joinable()) {
+        mThread.request_stop();
+        mThread.join();
+    }
+    if (mSocket >= 0) {
+        ::close(mSocket);
+        mSocket = -1;
+        Log::Info("Disconnected from TCP server.");
+    }
+    handleClosed();
+}
+
+void UringClient::setOnConnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnConnected = std::move(callback);
+}
+
+void UringClient::setOnDisconnected(ConnectionCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDisconnected = std::move(callback);
+}
+
+void UringClient::setOnDataReceived(DataCallback callback) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOnDataReceived = std::move(callback);
+}
+
+bool UringClient::isConnected() const {
+    return mConnected;
+}
+
+void UringClient::receive(std::stop_token stopToken) {
+    pollfd descriptor{ mSocket, POLLIN, 0 };
+    while (!stopToken.stop_requested()) {
+        const int ready = ::poll(&descriptor, 1, POLL_TIMEOUT_MS);
+        if (ready == 0 || (ready < 0 && errno == EINTR)) {
+            continue;
+        }
+
+        const ssize_t bytesReceived = ready < 0 ? -1 : ::recv(mSocket, mReceiveBuffer.data(), mReceiveBuffer.size(), 0);
+        if (bytesReceived <= 0) {
+            if (bytesReceived < 0) {
+                Log::Error(Print::composeMessage("TCP receive error: ", std::strerror(errno)));
+            } else {
+                Log::Info("TCP server closed the connection.");
+            }
+            handleClosed();
+            return;
+        }
+
+        mFrameBuffer.append(mReceiveBuffer.data(), static_cast<size_t>(bytesReceived));
+        size_t frameStart = 0;
+        size_t delimiterPos = mFrameBuffer.find(FRAME_DELIMITER);
+        while (delimiterPos != std::string::npos) {
+            if (delimiterPos > frameStart) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mOnDataReceived) {
+                    mOnDataReceived(mFrameBuffer.substr(frameStart, delimiterPos - frameStart));
+                }
+            }
+            frameStart = delimiterPos + 1;
+            delimiterPos = mFrameBuffer.find(FRAME_DELIMITER, frameStart);
+        }
+        mFrameBuffer.erase(0, frameStart);
+    }
+}
+
+void UringClient::handleClosed() {
+    if (!mConnected.exchange(false)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mOnDisconnected) {
+        mOnDisconnected();
+    }
+}
+
+} // namespace Streaming::Uring
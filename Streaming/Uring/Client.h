@@ -0,0 +1,43 @@
+#pragma once
+
+#include "IClient.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Streaming::Uring {
+
+// Plain TCP viewer for the io_uring server; frames are newline delimited on the wire.
+class UringClient : public IClient {
+public:
+    UringClient();
+    ~UringClient() override;
+public:
+    bool connect(const std::string& address, int port) override;
+    void disconnect() override;
+    void setOnConnected(ConnectionCallback callback) override;
+    void setOnDisconnected(ConnectionCallback callback) override;
+    void setOnDataReceived(DataCallback callback) override;
+    bool isConnected() const override;
+private:
+    void receive(std::stop_token stopToken);
+    void handleClosed();
+private:
+    using Buffer = std::string;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    int mSocket;
+    Buffer mReceiveBuffer;
+    Buffer mFrameBuffer;
+    std::jthread mThread;
+    AtomicFlag mConnected;
+    std::mutex mMutex;
+private:
+    ConnectionCallback mOnConnected;
+    ConnectionCallback mOnDisconnected;
+    DataCallback mOnDataReceived;
+};
+
+} // namespace Streaming::Uring
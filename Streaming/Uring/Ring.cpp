@@ -0,0 +1,169 @@
+#include "Ring.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace Streaming::Uring {
+
+Ring::Ring()
+    : mFd(-1)
+    , mSqRing(MAP_FAILED)
+    , mSqRingSize(0)
+    , mCqRing(MAP_FAILED)
+    , mCqRingSize(0)
+    , mSqes(nullptr)
+    , mSqesSize(0)
+    , mSqHead(nullptr)
+    , mSqTail(nullptr)
+    , mSqMask(nullptr)
+    , mSqArray(nullptr)
+    , mSqEntries(0)
+    , mSqLocalTail(0)
+    , mSqSubmitted(0)
+    , mCqHead(nullptr)
+    , mCqTail(nullptr)
+    , mCqMask(nullptr)
+    , mCqes(nullptr)
+{
+}
+
+Ring::~Ring() {
+    close();
+}
+
+bool Ring::init(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    // Every session can have a write in flight while accepts keep arriving, so the CQ gets extra room.
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+
+    mFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (mFd < 0) {
+        Log::Error(Print::composeMessage("io_uring_setup failed: ", std::strerror(errno)));
+        mFd = -1;
+        return false;
+    }
+
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        mSqRingSize = mCqRingSize = std::max(mSqRingSize, mCqRingSize);
+    }
+
+    mSqRing = ::mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED) {
+        Log::Error(Print::composeMessage("io_uring SQ ring mmap failed: ", std::strerror(errno)));
+        close();
+        return false;
+    }
+    if (singleMmap) {
+        mCqRing = mSqRing;
+    } else {
+        mCqRing = ::mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED) {
+            Log::Error(Print::composeMessage("io_uring CQ ring mmap failed: ", std::strerror(errno)));
+            close();
+            return false;
+        }
+    }
+
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        Log::Error(Print::composeMessage("io_uring SQE mmap failed: ", std::strerror(errno)));
+        close();
+        return false;
+    }
+    mSqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(mSqRing);
+    mSqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    mSqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    mSqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    mSqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    mSqEntries = params.sq_entries;
+    mSqLocalTail = *mSqTail;
+    mSqSubmitted = mSqLocalTail;
+
+    char* cq = static_cast<char*>(mCqRing);
+    mCqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    mCqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    mCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+void Ring::close() {
+    if (mSqes) {
+        ::munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRing != MAP_FAILED && mCqRing != mSqRing) {
+        ::munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = MAP_FAILED;
+    if (mSqRing != MAP_FAILED) {
+        ::munmap(mSqRing, mSqRingSize);
+        mSqRing = MAP_FAILED;
+    }
+    if (mFd >= 0) {
+        ::close(mFd);
+        mFd = -1;
+    }
+}
+
+bool Ring::registerBuffers(const iovec* buffers, unsigned count) {
+    if (::syscall(__NR_io_uring_register, mFd, IORING_REGISTER_BUFFERS, buffers, count) < 0) {
+        Log::Warning(Print::composeMessage("io_uring buffer registration failed: ", std::strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+io_uring_sqe* Ring::getSqe() {
+    const unsigned head = std::atomic_ref<unsigned>(*mSqHead).load(std::memory_order_acquire);
+    if (mSqLocalTail - head >= mSqEntries) {
+        return nullptr;
+    }
+    io_uring_sqe* sqe = &mSqes[mSqLocalTail & *mSqMask];
+    mSqArray[mSqLocalTail & *mSqMask] = mSqLocalTail & *mSqMask;
+    ++mSqLocalTail;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int Ring::submit() {
+    const unsigned pending = mSqLocalTail - mSqSubmitted;
+    if (pending == 0) {
+        return 0;
+    }
+    std::atomic_ref<unsigned>(*mSqTail).store(mSqLocalTail, std::memory_order_release);
+    const int submitted = enter(pending, 0, 0);
+    if (submitted > 0) {
+        mSqSubmitted += static_cast<unsigned>(submitted);
+    }
+    return submitted;
+}
+
+int Ring::waitCqe() {
+    return enter(0, 1, IORING_ENTER_GETEVENTS);
+}
+
+int Ring::enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    int result;
+    do {
+        result = static_cast<int>(::syscall(__NR_io_uring_enter, mFd, toSubmit, minComplete, flags, nullptr, 0));
+    } while (result < 0 && errno == EINTR);
+    return result < 0 ? -errno : result;
+}
+
+} // namespace Streaming::Uring
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+
+namespace Streaming::Uring {
+
+// Minimal io_uring wrapper on top of the raw system calls, so the backend does not
+// depend on liburing. Submission and completion sides are each used by one thread at a time.
+class Ring {
+public:
+    Ring();
+    ~Ring();
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+public:
+    bool init(unsigned entries);
+    void close();
+    bool registerBuffers(const iovec* buffers, unsigned count);
+public:
+    io_uring_sqe* getSqe();
+    int submit();
+    int waitCqe();
+    template <typename Handler>
+    unsigned forEachCqe(Handler&& handler);
+private:
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags);
+private:
+    int mFd;
+    void* mSqRing;
+    size_t mSqRingSize;
+    void* mCqRing;
+    size_t mCqRingSize;
+    io_uring_sqe* mSqes;
+    size_t mSqesSize;
+private:
+    unsigned* mSqHead;
+    unsigned* mSqTail;
+    unsigned* mSqMask;
+    unsigned* mSqArray;
+    unsigned mSqEntries;
+    unsigned mSqLocalTail;
+    unsigned mSqSubmitted;
+    unsigned* mCqHead;
+    unsigned* mCqTail;
+    unsigned* mCqMask;
+    io_uring_cqe* mCqes;
+};
+
+template <typename Handler>
+unsigned Ring::forEachCqe(Handler&& handler) {
+    unsigned head = std::atomic_ref<unsigned>(*mCqHead).load(std::memory_order_relaxed);
+    const unsigned tail = std::atomic_ref<unsigned>(*mCqTail).load(std::memory_order_acquire);
+    unsigned count = 0;
+    for (; head != tail; ++head, ++count) {
+        handler(mCqes[head & *mCqMask]);
+    }
+    std::atomic_ref<unsigned>(*mCqHead).store(head, std::memory_order_release);
+    return count;
+}
+
+} // namespace Streaming::Uring
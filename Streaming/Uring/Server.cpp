@@ -0,0 +1,360 @@
+#include "Server.h"
+#include "Log.h"
+#include "Print.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+namespace Streaming::Uring {
+
+namespace {
+    const unsigned RING_ENTRIES = 4096;
+    const int LISTEN_BACKLOG = 1024;
+    const size_t FRAME_SLOT_COUNT = 8;
+    const size_t FRAME_SLOT_SIZE = 256 * 1024;
+    const int OPERATION_SHIFT = 56;
+    const uint64_t FD_MASK = 0xFFFFFFFF;
+}
+
+UringServer::UringServer()
+    : mListenFd(-1)
+    , mBuffersRegistered(false)
+    , mMultishotAccept(true)
+    , mDroppedFrames(0)
+    , mMetrics(TransportMetrics::create("io-uring"))
+    , mRunning(false)
+{
+}
+
+UringServer::~UringServer() {
+    if (mRunning) {
+        stop();
+    }
+}
+
+bool UringServer::start(const std::string& address, int port, int /*threadCount*/) {
+    if (mRunning) {
+        Log::Warning("UringServer::start called but server is already running.");
+        return true;
+    }
+    Log::Info(Print::composeMessage("Starting io_uring server on ", address, ":", port));
+
+    if (!mRing.init(RING_ENTRIES)) {
+        return false;
+    }
+    if (!openListener(address, port)) {
+        mRing.close();
+        return false;
+    }
+
+    mSlots.assign(FRAME_SLOT_COUNT, FrameSlot{});
+    mFrameMemory = std::make_unique<char[]>(FRAME_SLOT_COUNT * FRAME_SLOT_SIZE);
+    std::vector<iovec> buffers(FRAME_SLOT_COUNT);
+    for (size_t i = 0; i < FRAME_SLOT_COUNT; ++i) {
+        buffers[i].iov_base = mFrameMemory.get() + i * FRAME_SLOT_SIZE;
+        buffers[i].iov_len = FRAME_SLOT_SIZE;
+    }
+    // Registration pins memory and counts against RLIMIT_MEMLOCK; plain sends are the fallback.
+    mBuffersRegistered = mRing.registerBuffers(buffers.data(), static_cast<unsigned>(buffers.size()));
+    if (mBuffersRegistered) {
+        // Fixed writes cannot pass MSG_NOSIGNAL, a viewer hanging up must not kill the process.
+        std::signal(SIGPIPE, SIG_IGN);
+    }
+    Log::Info(Print::composeMessage("io_uring frame buffers ", mBuffersRegistered ? "registered" : "not registered, using plain sends"));
+
+    mMultishotAccept = true;
+    mDroppedFrames = 0;
+    mRunning = true;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        queueAccept();
+        mRing.submit();
+    }
+    mThread = std::jthread([this]() { run(); });
+
+    Log::Info("io_uring server started");
+    return true;
+}
+
+void UringServer::stop() {
+    if (!mRunning.exchange(false)) {
+        Log::Warning("UringServer::stop called but server is not running.");
+        return;
+    }
+    Log::Info("Stopping io_uring server...");
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        queueWake();
+        mRing.submit();
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+
+    for (const auto& [fd, session] : mSessions) {
+        ::close(fd);
+    }
+    mSessions.clear();
+    mMetrics.sessions.set(0);
+    if (mListenFd >= 0) {
+        ::close(mListenFd);
+        mListenFd = -1;
+    }
+    // Closing the ring cancels whatever is still in flight before the frame memory goes away.
+    mRing.close();
+    mFrameMemory.reset();
+    mSlots.clear();
+
+    Log::Info(Print::composeMessage("io_uring server stopped, dropped frames: ", mDroppedFrames));
+}
+
+void UringServer::broadcastData(const std::string& data) {
+    if (!mRunning) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mSessions.empty()) {
+        return;
+    }
+    if (data.size() > FRAME_SLOT_SIZE) {
+        Log::Warning(Print::composeMessage("Frame of ", data.size(), " bytes does not fit an io_uring frame slot"));
+        ++mDroppedFrames;
+        mMetrics.droppedFrames.increment();
+        return;
+    }
+    const int slot = findFreeSlot();
+    if (slot < 0) {
+        ++mDroppedFrames;
+        mMetrics.droppedFrames.increment();
+        return;
+    }
+
+    std::memcpy(mFrameMemory.get() + slot * FRAME_SLOT_SIZE, data.data(), data.size());
+    mSlots[slot].length = data.size();
+
+    for (auto& [fd, session] : mSessions) {
+        ++mSlots[slot].references;
+        if (session.currentSlot < 0) {
+            session.currentSlot = slot;
+            session.offset = 0;
+            queueWrite(fd, session);
+        } else {
+            if (session.pendingSlot >= 0) {
+                // The viewer never saw the frame it had pending.
+                releaseSlot(session.pendingSlot);
+                mMetrics.droppedFrames.increment();
+            }
+            session.pendingSlot = slot;
+        }
+        mMetrics.queueDepth.observe(session.pendingSlot >= 0 ? 2.0 : 1.0);
+    }
+    mRing.submit();
+}
+
+bool UringServer::isRunning() const {
+    return mRunning;
+}
+
+bool UringServer::openListener(const std::string& address, int port) {
+    sockaddr_in endpoint;
+    std::memset(&endpoint, 0, sizeof(endpoint));
+    endpoint.sin_family = AF_INET;
+    endpoint.sin_port = htons(static_cast<uint16_t>(port));
+    if (::inet_pton(AF_INET, address.c_str(), &endpoint.sin_addr) != 1) {
+        Log::Error(Print::composeMessage("Invalid io_uring server address: ", address));
+        return false;
+    }
+
+    mListenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (mListenFd < 0) {
+        Log::Error(Print::composeMessage("socket failed: ", std::strerror(errno)));
+        return false;
+    }
+    int enable = 1;
+    ::setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    if (::bind(mListenFd, reinterpret_cast<sockaddr*>(&endpoint), sizeof(endpoint)) != 0
+        || ::listen(mListenFd, LISTEN_BACKLOG) != 0) {
+        Log::Error(Print::composeMessage("Failed to listen on ", address, ":", port, ": ", std::strerror(errno)));
+        ::close(mListenFd);
+        mListenFd = -1;
+        return false;
+    }
+    return true;
+}
+
+void UringServer::run() {
+    while (true) {
+        const int result = mRing.waitCqe();
+        if (result < 0 && result != -EAGAIN && result != -EBUSY) {
+            Log::Error(Print::composeMessage("io_uring wait failed: ", std::strerror(-result)));
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRing.forEachCqe([this](const io_uring_cqe& cqe) { handleCompletion(cqe); });
+        if (!mRunning) {
+            break;
+        }
+        mRing.submit();
+    }
+}
+
+void UringServer::handleCompletion(const io_uring_cqe& cqe) {
+    const auto operation = static_cast<Operation>(cqe.user_data >> OPERATION_SHIFT);
+    const int fd = static_cast<int>(cqe.user_data & FD_MASK);
+    switch (operation) {
+    case Operation::Accept:
+        handleAccept(cqe);
+        break;
+    case Operation::Write:
+        handleWrite(fd, cqe.res);
+        break;
+    case Operation::Wake:
+        break;
+    }
+}
+
+void UringServer::handleAccept(const io_uring_cqe& cqe) {
+    if (cqe.res >= 0) {
+        const int fd = cqe.res;
+        int enable = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        mSessions[fd] = Session{};
+        mMetrics.accepted.increment();
+        mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+        Log::Debug("io_uring session added. Total sessions: {}", mSessions.size());
+    } else if (cqe.res == -EINVAL && mMultishotAccept) {
+        Log::Info("Multishot accept is not supported by this kernel, accepting one connection per request");
+        mMultishotAccept = false;
+    } else if (mRunning) {
+        Log::Error("io_uring accept error: {}", std::strerror(-cqe.res));
+    }
+
+    if (mRunning && !(mMultishotAccept && (cqe.flags & IORING_CQE_F_MORE))) {
+        queueAccept();
+    }
+}
+
+void UringServer::handleWrite(int fd, int result) {
+    auto it = mSessions.find(fd);
+    if (it == mSessions.end()) {
+        return;
+    }
+    Session& session = it->second;
+
+    if (result < 0) {
+        if (result == -EAGAIN || result == -EINTR) {
+            queueWrite(fd, session);
+            return;
+        }
+        if (result != -EPIPE && result != -ECONNRESET) {
+            Log::Error("io_uring write error: {}", std::strerror(-result));
+        }
+        closeSession(fd);
+        return;
+    }
+
+    session.offset += static_cast<size_t>(result);
+    if (session.offset < mSlots[session.currentSlot].length) {
+        queueWrite(fd, session);
+        return;
+    }
+
+    releaseSlot(session.currentSlot);
+    session.currentSlot = session.pendingSlot;
+    session.pendingSlot = -1;
+    session.offset = 0;
+    if (session.currentSlot >= 0) {
+        queueWrite(fd, session);
+    }
+}
+
+void UringServer::queueAccept() {
+    io_uring_sqe* sqe = acquireSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = mListenFd;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    if (mMultishotAccept) {
+        sqe->ioprio |= IORING_ACCEPT_MULTISHOT;
+    }
+    sqe->user_data = composeUserData(Operation::Accept, mListenFd);
+}
+
+void UringServer::queueWrite(int fd, Session& session) {
+    const FrameSlot& slot = mSlots[session.currentSlot];
+    char* data = mFrameMemory.get() + session.currentSlot * FRAME_SLOT_SIZE + session.offset;
+
+    io_uring_sqe* sqe = acquireSqe();
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = static_cast<uint32_t>(slot.length - session.offset);
+    if (mBuffersRegistered) {
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->buf_index = static_cast<uint16_t>(session.currentSlot);
+    } else {
+        sqe->opcode = IORING_OP_SEND;
+        sqe->msg_flags = MSG_NOSIGNAL;
+    }
+    sqe->user_data = composeUserData(Operation::Write, fd);
+}
+
+void UringServer::queueWake() {
+    io_uring_sqe* sqe = acquireSqe();
+    sqe->opcode = IORING_OP_NOP;
+    sqe->user_data = composeUserData(Operation::Wake, 0);
+}
+
+io_uring_sqe* UringServer::acquireSqe() {
+    // A fan-out larger than the submission queue is flushed in chunks.
+    io_uring_sqe* sqe = mRing.getSqe();
+    while (!sqe) {
+        mRing.submit();
+        sqe = mRing.getSqe();
+    }
+    return sqe;
+}
+
+int UringServer::findFreeSlot() const {
+    for (size_t i = 0; i < mSlots.size(); ++i) {
+        if (mSlots[i].references == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void UringServer::releaseSlot(int slot) {
+    --mSlots[slot].references;
+}
+
+void UringServer::closeSession(int fd) {
+    auto it = mSessions.find(fd);
+    if (it == mSessions.end()) {
+        return;
+    }
+    if (it->second.currentSlot >= 0) {
+        releaseSlot(it->second.currentSlot);
+    }
+    if (it->second.pendingSlot >= 0) {
+        releaseSlot(it->second.pendingSlot);
+    }
+    mSessions.erase(it);
+    mMetrics.sessions.set(static_cast<int64_t>(mSessions.size()));
+    ::close(fd);
+    Log::Debug("io_uring session removed. Total sessions: {}", mSessions.size());
+}
+
+uint64_t UringServer::composeUserData(Operation operation, int fd) {
+    return (static_cast<uint64_t>(operation) << OPERATION_SHIFT) | (static_cast<uint64_t>(fd) & FD_MASK);
+}
+
+} // namespace Streaming::Uring
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "IServer.h"
+#include "Ring.h"
+#include "TransportMetrics.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Streaming::Uring {
+
+// Experimental TCP broadcast backend driven by io_uring. Frames are copied once into a
+// registered buffer and the writes for every viewer go out in a single submission;
+// viewers still busy with an earlier frame only keep the newest one pending.
+class UringServer : public IServer {
+public:
+    UringServer();
+    ~UringServer() override;
+public:
+    bool start(const std::string& address, int port, int threadCount = 1) override;
+    void stop() override;
+    void broadcastData(const std::string& data) override;
+    bool isRunning() const override;
+private:
+    struct Session {
+        int currentSlot = -1;
+        size_t offset = 0;
+        int pendingSlot = -1;
+    };
+    struct FrameSlot {
+        size_t length = 0;
+        int references = 0;
+    };
+    enum class Operation : uint64_t {
+        Accept = 1,
+        Write,
+        Wake
+    };
+private:
+    bool openListener(const std::string& address, int port);
+    void run();
+    void handleCompletion(const io_uring_cqe& cqe);
+    void handleAccept(const io_uring_cqe& cqe);
+    void handleWrite(int fd, int result);
+    void queueAccept();
+    void queueWrite(int fd, Session& session);
+    void queueWake();
+    io_uring_sqe* acquireSqe();
+    int findFreeSlot() const;
+    void releaseSlot(int slot);
+    void closeSession(int fd);
+private:
+    static uint64_t composeUserData(Operation operation, int fd);
+private:
+    using Sessions = std::unordered_map<int, Session>;
+    using FrameSlots = std::vector<FrameSlot>;
+    using FrameMemory = std::unique_ptr<char[]>;
+    using AtomicFlag = std::atomic<bool>;
+private:
+    Ring mRing;
+    int mListenFd;
+    Sessions mSessions;
+    FrameSlots mSlots;
+    FrameMemory mFrameMemory;
+    bool mBuffersRegistered;
+    bool mMultishotAccept;
+    uint64_t mDroppedFrames;
+    TransportMetrics mMetrics;
+    std::mutex mMutex;
+    std::jthread mThread;
+    AtomicFlag mRunning;
+};
+
+} // namespace Streaming::Uring